@@ -60,6 +60,8 @@ namespace gnote {
 AddinInfo::AddinInfo(const Glib::ustring & info_file)
   : m_category(ADDIN_CATEGORY_UNKNOWN)
   , m_default_enabled(false)
+  , m_load_on_demand(false)
+  , m_load_on_note_open(false)
 {
   load_from_file(info_file);
 }
@@ -83,6 +85,12 @@ void AddinInfo::load_from_file(const Glib::ustring & info_file)
     if(addin_info->has_key(ADDIN_INFO, "DefaultEnabled")) {
       m_default_enabled = addin_info->get_boolean(ADDIN_INFO, "DefaultEnabled");
     }
+    if(addin_info->has_key(ADDIN_INFO, "LoadOnDemand")) {
+      m_load_on_demand = addin_info->get_boolean(ADDIN_INFO, "LoadOnDemand");
+    }
+    if(addin_info->has_key(ADDIN_INFO, "LoadOnNoteOpen")) {
+      m_load_on_note_open = addin_info->get_boolean(ADDIN_INFO, "LoadOnNoteOpen");
+    }
     m_addin_module = addin_info->get_string(ADDIN_INFO, "Module");
     m_libgnote_release = addin_info->get_string(ADDIN_INFO, "LibgnoteRelease");
     m_libgnote_version_info = addin_info->get_string(ADDIN_INFO, "LibgnoteVersionInfo");
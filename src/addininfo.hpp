@@ -41,7 +41,12 @@ enum AddinCategory {
 class AddinInfo
 {
 public:
-  AddinInfo(){}
+  AddinInfo()
+    : m_category(ADDIN_CATEGORY_UNKNOWN)
+    , m_default_enabled(false)
+    , m_load_on_demand(false)
+    , m_load_on_note_open(false)
+    {}
   explicit AddinInfo(const Glib::ustring & info_file);
   void load_from_file(const Glib::ustring & info_file);
 
@@ -77,6 +82,18 @@ public:
     {
       return m_default_enabled;
     }
+  /// Module is not loaded on startup, but when one of its actions is first
+  /// activated or the note actions menu is built.
+  bool load_on_demand() const
+    {
+      return m_load_on_demand;
+    }
+  /// On demand module, whose note addins need to see the note opened
+  /// (shortcuts, action state), is loaded when the first note is opened.
+  bool load_on_note_open() const
+    {
+      return m_load_on_note_open;
+    }
   const Glib::ustring & addin_module() const
     {
       return m_addin_module;
@@ -108,6 +125,8 @@ private:
   Glib::ustring m_version;
   Glib::ustring m_copyright;
   bool m_default_enabled;
+  bool m_load_on_demand;
+  bool m_load_on_note_open;
   Glib::ustring m_addin_module;
   Glib::ustring m_libgnote_release;
   Glib::ustring m_libgnote_version_info;
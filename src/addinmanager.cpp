@@ -36,6 +36,7 @@
 #include "debug.hpp"
 #include "iactionmanager.hpp"
 #include "ignote.hpp"
+#include "tracing.hpp"
 #include "watchers.hpp"
 #include "notebooks/notebookapplicationaddin.hpp"
 #include "notebooks/notebooknoteaddin.hpp"
@@ -157,11 +158,11 @@ namespace {
         continue;
       }
 
-      m_note_manager.find_by_uri(iter->first, [this, id=std::move(id), f, &id_addin_map](NoteBase & note) {
+      m_note_manager.find_by_uri(iter->first, [this, &id, f, &id_addin_map](NoteBase & note) {
         NoteAddin *const addin = dynamic_cast<NoteAddin*>((*f)());
         if(addin) {
           addin->initialize(m_gnote, std::static_pointer_cast<Note>(note.shared_from_this()));
-          id_addin_map.insert(std::make_pair(std::move(id), addin));
+          id_addin_map.insert(std::make_pair(id, addin));
         }
       });
     }
@@ -283,8 +284,18 @@ namespace {
     Glib::ustring global_path = LIBDIR "/" PACKAGE_NAME "/plugins/" PACKAGE_VERSION;
     Glib::ustring local_path = m_gnote_conf_dir + "/plugins";
 
+    TRACE_SPAN("load_plugins");
     load_addin_infos(global_path, local_path);
-    std::vector<Glib::ustring> enabled_addins = get_enabled_addins();
+    std::vector<Glib::ustring> enabled_addins;
+    for(auto & module : get_enabled_addins()) {
+      AddinInfo info = get_info_for_module(module);
+      if(info.load_on_demand()) {
+        m_deferred_modules.push_back(info.id());
+      }
+      else {
+        enabled_addins.push_back(module);
+      }
+    }
     m_module_manager.load_modules(enabled_addins);
 
     const sharp::ModuleMap & modules = m_module_manager.get_modules();
@@ -368,6 +379,109 @@ namespace {
         delete iface;
       }
     }
+
+    if(has_deferred_note_open_modules()) {
+      m_deferred_modules_cids.push_back(static_cast<Note&>(note).signal_opened().connect(
+        sigc::hide(sigc::mem_fun(*this, &AddinManager::load_note_open_modules))));
+    }
+  }
+
+  void AddinManager::load_deferred_modules()
+  {
+    std::vector<Glib::ustring> deferred;
+    std::swap(deferred, m_deferred_modules);
+    for(auto & id : deferred) {
+      load_deferred_module(id);
+    }
+    disconnect_note_open_modules();
+  }
+
+  void AddinManager::load_note_open_modules()
+  {
+    std::vector<Glib::ustring> to_load;
+    for(auto iter = m_deferred_modules.begin(); iter != m_deferred_modules.end();) {
+      if(get_addin_info(*iter).load_on_note_open()) {
+        to_load.push_back(*iter);
+        iter = m_deferred_modules.erase(iter);
+      }
+      else {
+        ++iter;
+      }
+    }
+    for(auto & id : to_load) {
+      load_deferred_module(id);
+    }
+    disconnect_note_open_modules();
+  }
+
+  bool AddinManager::load_module_for_action(const Glib::ustring & action)
+  {
+    for(auto iter = m_deferred_modules.begin(); iter != m_deferred_modules.end(); ++iter) {
+      AddinInfo info = get_addin_info(*iter);
+      if(info.actions().find(action) != info.actions().end()) {
+        Glib::ustring id = *iter;
+        m_deferred_modules.erase(iter);
+        return load_deferred_module(id) != nullptr;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Glib::ustring> AddinManager::get_deferred_actions() const
+  {
+    std::vector<Glib::ustring> actions;
+    for(auto & id : m_deferred_modules) {
+      AddinInfo info = get_addin_info(id);
+      for(auto & action : info.actions()) {
+        actions.push_back(action.first);
+      }
+    }
+    return actions;
+  }
+
+  bool AddinManager::has_deferred_note_open_modules() const
+  {
+    for(auto & id : m_deferred_modules) {
+      if(get_addin_info(id).load_on_note_open()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void AddinManager::disconnect_note_open_modules()
+  {
+    if(has_deferred_note_open_modules()) {
+      return;
+    }
+    for(auto & cid : m_deferred_modules_cids) {
+      cid.disconnect();
+    }
+    m_deferred_modules_cids.clear();
+  }
+
+  sharp::DynamicModule *AddinManager::load_deferred_module(const Glib::ustring & id)
+  {
+    TRACE_SPAN("load_deferred_plugins");
+    AddinInfo info = get_addin_info(id);
+    sharp::DynamicModule *dmod = m_module_manager.load_module(info.addin_module());
+    if(!dmod) {
+      return nullptr;
+    }
+
+    dmod->enabled(true);
+    add_module_addins(id, dmod);
+    // add_module_addins only registers the factory, notes are already loaded
+    auto note_addin = m_note_addin_infos.find(id);
+    if(note_addin != m_note_addin_infos.end()) {
+      load_note_addin(Glib::ustring(id), note_addin->second);
+    }
+    return dmod;
+  }
+
+  bool AddinManager::is_module_deferred(const Glib::ustring & id) const
+  {
+    return std::find(m_deferred_modules.begin(), m_deferred_modules.end(), id) != m_deferred_modules.end();
   }
 
   std::vector<NoteAddin*> AddinManager::get_note_addins(const NoteBase & note) const
@@ -497,7 +611,7 @@ namespace {
         iter != m_addin_infos.end(); ++iter) {
       const Glib::ustring & mod_id = iter->first;
       sharp::ModuleMap::const_iterator mod_iter = modules.find(iter->second.addin_module());
-      bool enabled = mod_iter != modules.end() && mod_iter->second->is_enabled();
+      bool enabled = (mod_iter != modules.end() && mod_iter->second->is_enabled()) || is_module_deferred(mod_id);
       global_addins_prefs->set_boolean("Enabled", mod_id, enabled);
     }
 
@@ -535,6 +649,10 @@ namespace {
 
   bool AddinManager::is_module_loaded(const Glib::ustring & id) const
   {
+    // deferred modules get loaded by get_module()
+    if(is_module_deferred(id)) {
+      return true;
+    }
     AddinInfo info = get_addin_info(id);
     return m_module_manager.get_module(info.addin_module());
   }
@@ -544,6 +662,11 @@ namespace {
     AddinInfo info = get_addin_info(id);
     sharp::DynamicModule *module = m_module_manager.get_module(info.addin_module());
     if(!module) {
+      auto deferred = std::find(m_deferred_modules.begin(), m_deferred_modules.end(), id);
+      if(deferred != m_deferred_modules.end()) {
+        m_deferred_modules.erase(deferred);
+        return load_deferred_module(id);
+      }
       module = m_module_manager.load_module(info.addin_module());
       if(module) {
         add_module_addins(id, module);
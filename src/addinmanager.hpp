@@ -81,6 +81,13 @@ public:
   AddinInfo get_addin_info(const AbstractAddin & addin) const;
   bool is_module_loaded(const Glib::ustring & id) const;
   sharp::DynamicModule *get_module(const Glib::ustring & id);
+  /// Load all on demand modules, so their note addins can add menu items.
+  void load_deferred_modules();
+  /// Load the on demand module, that registered the action.
+  /// Returns true, if a module was loaded.
+  bool load_module_for_action(const Glib::ustring & action);
+  /// Actions registered by on demand modules, that are not loaded yet.
+  std::vector<Glib::ustring> get_deferred_actions() const;
 
   Gtk::Widget *create_addin_preference_widget(const Glib::ustring & id);
 private:
@@ -90,6 +97,11 @@ private:
   std::vector<Glib::ustring> get_enabled_addins() const;
   void initialize_sharp_addins();
   void add_module_addins(const Glib::ustring & mod_id, sharp::DynamicModule * dmod);
+  void load_note_open_modules();
+  sharp::DynamicModule *load_deferred_module(const Glib::ustring & id);
+  bool is_module_deferred(const Glib::ustring & id) const;
+  bool has_deferred_note_open_modules() const;
+  void disconnect_note_open_modules();
   AddinInfo get_info_for_module(const Glib::ustring & module) const;
   void register_addin_actions() const;
     
@@ -102,6 +114,10 @@ private:
   sharp::ModuleManager m_module_manager;
   std::vector<std::unique_ptr<sharp::IfaceFactoryBase>> m_builtin_ifaces;
   AddinInfoMap m_addin_infos;
+  /// Enabled LoadOnDemand plugins, not loaded until their action is used
+  /// or, for LoadOnNoteOpen ones, until a note is opened
+  std::vector<Glib::ustring> m_deferred_modules;
+  std::vector<sigc::connection> m_deferred_modules_cids;
   /// Key = TypeExtensionNode.Id
   typedef std::map<Glib::ustring, std::unique_ptr<ApplicationAddin>> AppAddinMap;
   AppAddinMap                               m_app_addins;
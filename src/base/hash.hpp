@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2023 Aurimas Cernius
  *
  * This program is free software: you can redistribute it and/or modify
@@ -21,6 +22,8 @@
 #ifndef __HASH_HPP__
 #define __HASH_HPP__
 
+#include <cstdint>
+#include <cstring>
 #include <string_view>
 
 #include <glibmm/ustring.h>
@@ -28,22 +31,177 @@
 
 namespace gnote {
 
+namespace hash_detail {
+
+const std::uint64_t P0 = 0xa0761d6478bd642full;
+const std::uint64_t P1 = 0xe7037ed1a0b428dbull;
+const std::uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+const std::uint64_t P3 = 0x589965cc75374cc3ull;
+
+// 64x64 bit multiplication, a and b get low and high halves of the result
+inline void mul128(std::uint64_t & a, std::uint64_t & b)
+{
+#ifdef __SIZEOF_INT128__
+  __uint128_t r = static_cast<__uint128_t>(a) * b;
+  a = static_cast<std::uint64_t>(r);
+  b = static_cast<std::uint64_t>(r >> 64);
+#else
+  std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+  std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  std::uint64_t t = rl + (rm0 << 32);
+  std::uint64_t c = t < rl;
+  std::uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  a = lo;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+{
+  mul128(a, b);
+  return a ^ b;
+}
+
+inline std::uint64_t read64(const unsigned char *p)
+{
+  std::uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline std::uint64_t read32(const unsigned char *p)
+{
+  std::uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+}
+
+/// Fast non-cryptographic hash (wyhash construction). Values are only stable within one process
+/// and byte order, never persist them.
+inline std::uint64_t hash_bytes(const void *key, std::size_t len, std::uint64_t seed = 0)
+{
+  using namespace hash_detail;
+  const unsigned char *p = static_cast<const unsigned char*>(key);
+  seed ^= mix(seed ^ P0, P1);
+  std::uint64_t a, b;
+  if(len <= 16) {
+    if(len >= 4) {
+      std::size_t offset = (len >> 3) << 2;
+      a = (read32(p) << 32) | read32(p + offset);
+      b = (read32(p + len - 4) << 32) | read32(p + len - 4 - offset);
+    }
+    else if(len > 0) {
+      a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[len >> 1]) << 8) | p[len - 1];
+      b = 0;
+    }
+    else {
+      a = b = 0;
+    }
+  }
+  else {
+    std::size_t i = len;
+    if(i > 48) {
+      std::uint64_t seed1 = seed, seed2 = seed;
+      do {
+        seed = mix(read64(p) ^ P1, read64(p + 8) ^ seed);
+        seed1 = mix(read64(p + 16) ^ P2, read64(p + 24) ^ seed1);
+        seed2 = mix(read64(p + 32) ^ P3, read64(p + 40) ^ seed2);
+        p += 48;
+        i -= 48;
+      } while(i > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while(i > 16) {
+      seed = mix(read64(p) ^ P1, read64(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = read64(p + i - 16);
+    b = read64(p + i - 8);
+  }
+
+  a ^= P1;
+  b ^= seed;
+  mul128(a, b);
+  return mix(a ^ P0 ^ len, b ^ P1);
+}
+
+
 template <typename T>
 class Hash
 {
 };
 
+template <>
+class Hash<std::string_view>
+{
+public:
+  std::size_t operator()(std::string_view s) const noexcept
+  {
+    return static_cast<std::size_t>(hash_bytes(s.data(), s.size()));
+  }
+};
+
 template <>
 class Hash<Glib::ustring>
 {
 public:
   std::size_t operator()(const Glib::ustring & s) const noexcept
   {
-    std::string_view sv(s.c_str(), s.bytes());
-    return m_hash(sv);
+    return static_cast<std::size_t>(hash_bytes(s.data(), s.bytes()));
   }
+};
+
+
+/// Immutable string that computes its hash once, for keys that are hashed over and over.
+class HashedString
+{
+public:
+  HashedString(Glib::ustring && s)
+    : m_str(std::move(s))
+    , m_hash(Hash<Glib::ustring>()(m_str))
+  {}
+  HashedString(const Glib::ustring & s)
+    : m_str(s)
+    , m_hash(Hash<Glib::ustring>()(m_str))
+  {}
+
+  const Glib::ustring & str() const
+    {
+      return m_str;
+    }
+  operator const Glib::ustring & () const
+    {
+      return m_str;
+    }
+  std::size_t hash() const
+    {
+      return m_hash;
+    }
+  bool operator==(const HashedString & other) const
+    {
+      return m_hash == other.m_hash && m_str.raw() == other.m_str.raw();
+    }
+  bool operator!=(const HashedString & other) const
+    {
+      return !(*this == other);
+    }
 private:
-  std::hash<std::string_view> m_hash;
+  Glib::ustring m_str;
+  std::size_t m_hash;
+};
+
+template <>
+class Hash<HashedString>
+{
+public:
+  std::size_t operator()(const HashedString & s) const noexcept
+  {
+    return s.hash();
+  }
 };
 
 }
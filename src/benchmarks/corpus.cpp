@@ -0,0 +1,189 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glib.h>
+
+#include "corpus.hpp"
+
+
+namespace bench {
+
+namespace {
+
+// most common first, words are picked with a skewed distribution
+const char *ASCII_WORDS[] = {
+  "the", "note", "and", "meeting", "project", "with", "idea", "list", "draft", "review",
+  "plan", "budget", "call", "email", "design", "travel", "recipe", "garden", "book", "music",
+  "server", "backup", "invoice", "report", "schedule", "summary", "question", "answer", "ticket", "release",
+  "kitchen", "weekend", "library", "account", "password", "printer", "holiday", "birthday", "doctor", "museum",
+  "quarterly", "milestone", "prototype", "benchmark", "regression", "changelog", "whiteboard", "spreadsheet", "newsletter", "workshop",
+  "aardvark", "zeppelin", "quixotic", "xylophone",
+  // keep escaped entries at the end, they never go to titles
+  "R&amp;D", "&lt;draft&gt;",
+};
+const unsigned ASCII_TITLE_WORDS = G_N_ELEMENTS(ASCII_WORDS) - 2;
+
+const char *UNICODE_WORDS[] = {
+  "žąsis", "ąžuolas", "straße", "café", "naïve", "привет", "заметка", "Ελληνικά",
+  "日本語", "メモ", "中文", "笔记", "한국어", "עברית", "العربية", "😀",
+};
+
+
+class Random
+{
+public:
+  explicit Random(std::uint64_t seed)
+    : m_state(seed)
+    {}
+  // splitmix64
+  std::uint64_t next()
+    {
+      std::uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      return z ^ (z >> 31);
+    }
+  unsigned below(unsigned n)
+    {
+      return n ? next() % n : 0;
+    }
+  double unit()
+    {
+      return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+  // small indexes are much more likely
+  unsigned skewed(unsigned n)
+    {
+      double u = unit();
+      return static_cast<unsigned>(n * u * u);
+    }
+private:
+  std::uint64_t m_state;
+};
+
+
+const char *random_word(Random & random, const CorpusOptions & options)
+{
+  if(random.unit() < options.unicode_ratio) {
+    return UNICODE_WORDS[random.skewed(G_N_ELEMENTS(UNICODE_WORDS))];
+  }
+  return ASCII_WORDS[random.skewed(G_N_ELEMENTS(ASCII_WORDS))];
+}
+
+
+Glib::ustring sentence(Random & random, const CorpusOptions & options, const std::vector<CorpusNote> & notes, unsigned words)
+{
+  Glib::ustring text;
+  for(unsigned i = 0; i < words; ++i) {
+    if(i > 0) {
+      text += ' ';
+    }
+    unsigned style = random.below(40);
+    if(style == 0) {
+      text += "<bold>";
+      text += random_word(random, options);
+      text += "</bold>";
+    }
+    else if(style == 1) {
+      text += "<italic>";
+      text += random_word(random, options);
+      text += "</italic>";
+    }
+    else {
+      text += random_word(random, options);
+    }
+
+    if(random.unit() < options.link_density) {
+      text += " <link:internal>";
+      text += notes[random.below(notes.size())].title;
+      text += "</link:internal>";
+    }
+  }
+  return text;
+}
+
+}
+
+
+Corpus::Corpus(const CorpusOptions & options)
+{
+  Random random(options.seed);
+
+  m_notes.resize(options.notes);
+  for(unsigned i = 0; i < options.notes; ++i) {
+    // number keeps titles unique
+    m_notes[i].title = Glib::ustring::compose("%1 %2 %3", ASCII_WORDS[random.below(ASCII_TITLE_WORDS)], i,
+                                              ASCII_WORDS[random.below(ASCII_TITLE_WORDS)]);
+  }
+
+  for(auto & note : m_notes) {
+    Glib::ustring content = "<note-content version=\"0.1\">";
+    content += note.title;
+    for(unsigned p = 0; p < options.paragraphs; ++p) {
+      content += "\n\n";
+      if(options.lists && random.below(6) == 0) {
+        unsigned items = 2 + random.below(3);
+        content += "<list>";
+        for(unsigned item = 0; item < items; ++item) {
+          content += "<list-item dir=\"ltr\">";
+          content += sentence(random, options, m_notes, 1 + options.words_per_paragraph / items);
+          if(item + 1 < items) {
+            content += '\n';
+          }
+          content += "</list-item>";
+        }
+        content += "</list>";
+      }
+      else {
+        content += sentence(random, options, m_notes, options.words_per_paragraph);
+      }
+    }
+    content += "</note-content>";
+    note.content = std::move(content);
+
+    if(options.tags) {
+      unsigned first = random.below(options.tags);
+      for(unsigned t = 0; t < options.tags_per_note && t < options.tags; ++t) {
+        note.tags.push_back(Glib::ustring::compose("tag%1", (first + t) % options.tags));
+      }
+    }
+
+    // some notes stay outside of notebooks
+    unsigned notebook = random.below(options.notebooks + options.notebooks / 3 + 1);
+    if(notebook < options.notebooks) {
+      note.notebook = Glib::ustring::compose("Notebook %1", notebook);
+    }
+  }
+}
+
+
+std::vector<Glib::ustring> Corpus::search_queries() const
+{
+  return {
+    ASCII_WORDS[0],
+    ASCII_WORDS[15],
+    ASCII_WORDS[ASCII_TITLE_WORDS - 1],
+    UNICODE_WORDS[0],
+    Glib::ustring::compose("%1 %2", ASCII_WORDS[1], ASCII_WORDS[3]),
+  };
+}
+
+}
+
@@ -0,0 +1,80 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _BENCHMARKS_CORPUS_HPP_
+#define _BENCHMARKS_CORPUS_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <glibmm/ustring.h>
+
+
+namespace bench {
+
+struct CorpusOptions
+{
+  unsigned notes = 1000;
+  unsigned paragraphs = 8;
+  unsigned words_per_paragraph = 40;
+  // probability of a word being followed by a link to another note
+  double link_density = 0.02;
+  // distinct tags and tags per note
+  unsigned tags = 20;
+  unsigned tags_per_note = 2;
+  // notes are spread over this many notebooks, some stay outside
+  unsigned notebooks = 5;
+  // probability of a word being non-ASCII
+  double unicode_ratio = 0.1;
+  bool lists = true;
+  std::uint64_t seed = 1;
+};
+
+struct CorpusNote
+{
+  Glib::ustring title;
+  // <note-content> element, as stored in note files
+  Glib::ustring content;
+  std::vector<Glib::ustring> tags;
+  // empty if none
+  Glib::ustring notebook;
+};
+
+/// Deterministic collection of generated notes: the same options always give the same notes,
+/// regardless of platform and standard library.
+class Corpus
+{
+public:
+  explicit Corpus(const CorpusOptions & options);
+
+  const std::vector<CorpusNote> & notes() const
+    {
+      return m_notes;
+    }
+  /// Common words, giving many search hits, and rare ones, giving few.
+  std::vector<Glib::ustring> search_queries() const;
+private:
+  std::vector<CorpusNote> m_notes;
+};
+
+}
+
+#endif
+
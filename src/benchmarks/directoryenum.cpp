@@ -0,0 +1,114 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Compares sharp::directory_get_files_with_ext with stat based enumeration.
+// Usage: directory-enum-bench [notes-dir] [iterations]
+// Without notes directory a temporary one with generated files is used.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <glib/gstdio.h>
+#include <glibmm/fileutils.h>
+#include <glibmm/init.h>
+#include <glibmm/miscutils.h>
+
+#include "sharp/directory.hpp"
+#include "sharp/fileinfo.hpp"
+
+
+namespace {
+
+const int GENERATED_NOTES = 10000;
+
+std::vector<Glib::ustring> stat_get_files_with_ext(const Glib::ustring & dir, const Glib::ustring & ext)
+{
+  std::vector<Glib::ustring> list;
+  Glib::Dir d(dir);
+  for(Glib::Dir::iterator itr = d.begin(); itr != d.end(); ++itr) {
+    const Glib::ustring file(dir + "/" + *itr);
+    const sharp::FileInfo file_info(file);
+    const Glib::ustring extension = file_info.get_extension();
+    if(Glib::file_test(file, Glib::FileTest::IS_REGULAR) && Glib::ustring(extension).lowercase() == ext) {
+      list.push_back(file);
+    }
+  }
+  return list;
+}
+
+template <typename F>
+double measure(const Glib::ustring & dir, int iterations, std::size_t & count, const F & func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; ++i) {
+    count = func(dir, ".note").size();
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+std::vector<Glib::ustring> get_files_with_ext(const Glib::ustring & dir, const Glib::ustring & ext)
+{
+  return sharp::directory_get_files_with_ext(dir, ext);
+}
+
+}
+
+
+int main(int argc, char **argv)
+{
+  Glib::init();
+
+  Glib::ustring dir;
+  bool generated = argc < 2;
+  if(generated) {
+    char temp_dir_tmpl[] = "/tmp/gnotebenchXXXXXX";
+    dir = g_mkdtemp(temp_dir_tmpl);
+    for(int i = 0; i < GENERATED_NOTES; ++i) {
+      auto name = Glib::ustring::compose("%1.note", i);
+      g_file_set_contents(Glib::build_filename(dir, name).c_str(), "", 0, nullptr);
+    }
+    g_mkdir(Glib::build_filename(dir, "Backup").c_str(), 0700);
+  }
+  else {
+    dir = argv[1];
+  }
+  int iterations = argc > 2 ? std::atoi(argv[2]) : 10;
+  if(iterations < 1) {
+    iterations = 1;
+  }
+
+  std::size_t stat_count = 0, count = 0;
+  double stat_ms = measure(dir, iterations, stat_count, stat_get_files_with_ext);
+  double ms = measure(dir, iterations, count, get_files_with_ext);
+  std::printf("files=%zu iterations=%d\n", count, iterations);
+  std::printf("stat_ms=%.2f d_type_ms=%.2f\n", stat_ms, ms);
+
+  if(generated) {
+    for(const auto & file : sharp::directory_get_files(dir)) {
+      g_remove(file.c_str());
+    }
+    g_remove(Glib::build_filename(dir, "Backup").c_str());
+    g_remove(dir.c_str());
+  }
+
+  return stat_count == count ? 0 : 1;
+}
@@ -0,0 +1,432 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Runs the main note operations over a generated corpus.
+// Usage: gnote-bench [--notes N] [--paragraphs N] [--link-density D] ... (see --help)
+// Prints one key=value line per measurement, times are per iteration in milliseconds.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include <glib/gstdio.h>
+#include <glibmm/fileutils.h>
+#include <glibmm/init.h>
+#include <glibmm/main.h>
+#include <glibmm/miscutils.h>
+#include <giomm/init.h>
+#include <gtk/gtk.h>
+#include <gtkmm/init.h>
+#include <gtkmm/textbuffer.h>
+
+#include "notebuffer.hpp"
+#include "notehtmlrenderer.hpp"
+#include "notetag.hpp"
+#include "search.hpp"
+#include "trie.hpp"
+#include "utils.hpp"
+#include "notebooks/notebook.hpp"
+#include "sharp/directory.hpp"
+#include "sharp/streamwriter.hpp"
+#include "synchronization/silentui.hpp"
+#include "test/testgnote.hpp"
+#include "test/testnote.hpp"
+#include "test/testnotemanager.hpp"
+#include "test/testsyncmanager.hpp"
+#include "corpus.hpp"
+
+
+// used by test::NoteManager
+void remove_dir(const Glib::ustring dir)
+{
+  for(auto & subdir : sharp::directory_get_directories(dir)) {
+    remove_dir(subdir);
+  }
+  for(auto & file : sharp::directory_get_files(dir)) {
+    g_remove(file.c_str());
+  }
+  g_rmdir(dir.c_str());
+}
+
+
+namespace {
+
+class Timer
+{
+public:
+  Timer()
+    : m_start(std::chrono::steady_clock::now())
+    {}
+  double ms(int iterations = 1) const
+    {
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+      return elapsed.count() / iterations;
+    }
+private:
+  std::chrono::steady_clock::time_point m_start;
+};
+
+
+// loads note files like gnote::NoteManager does, without the GUI parts
+class NoteManager
+  : public test::NoteManager
+{
+public:
+  NoteManager(const Glib::ustring & notes_dir, gnote::IGnote & g)
+    : test::NoteManager(notes_dir, g)
+    {}
+  void load_notes()
+    {
+      BulkMutation bulk(*this);
+      for(auto & file : sharp::directory_get_files_with_ext(notes_dir(), ".note")) {
+        add_note(note_load(std::move(file)));
+      }
+    }
+protected:
+  gnote::NoteBase::Ptr note_load(Glib::ustring && file_name) override
+    {
+      auto data = std::make_unique<gnote::NoteData>(gnote::NoteBase::url_from_path(file_name));
+      note_archiver().read_file(file_name, *data);
+      return test::Note::create(std::move(data), std::move(file_name), *this);
+    }
+};
+
+
+struct Options
+{
+  bench::CorpusOptions corpus;
+  int iterations = 5;
+  Glib::ustring xsl_file = EXPORT_TO_HTML_XSL;
+};
+
+
+bool parse_options(int argc, char **argv, Options & options)
+{
+  int notes = options.corpus.notes;
+  int paragraphs = options.corpus.paragraphs;
+  int words = options.corpus.words_per_paragraph;
+  int tags = options.corpus.tags;
+  int tags_per_note = options.corpus.tags_per_note;
+  int notebooks = options.corpus.notebooks;
+  gint64 seed = options.corpus.seed;
+  gboolean no_lists = FALSE;
+  gchar *xsl_file = nullptr;
+  const GOptionEntry entries[] =
+    {
+      { "notes", 0, 0, G_OPTION_ARG_INT, &notes, "Number of notes to generate", "N" },
+      { "paragraphs", 0, 0, G_OPTION_ARG_INT, &paragraphs, "Paragraphs per note", "N" },
+      { "words", 0, 0, G_OPTION_ARG_INT, &words, "Words per paragraph", "N" },
+      { "link-density", 0, 0, G_OPTION_ARG_DOUBLE, &options.corpus.link_density, "Probability of a link after a word", "D" },
+      { "tags", 0, 0, G_OPTION_ARG_INT, &tags, "Number of distinct tags", "N" },
+      { "tags-per-note", 0, 0, G_OPTION_ARG_INT, &tags_per_note, "Tags per note", "N" },
+      { "notebooks", 0, 0, G_OPTION_ARG_INT, &notebooks, "Number of notebooks", "N" },
+      { "unicode", 0, 0, G_OPTION_ARG_DOUBLE, &options.corpus.unicode_ratio, "Probability of a word being non-ASCII", "D" },
+      { "no-lists", 0, 0, G_OPTION_ARG_NONE, &no_lists, "Do not generate bulleted lists", NULL },
+      { "seed", 0, 0, G_OPTION_ARG_INT64, &seed, "Corpus generator seed", "N" },
+      { "iterations", 0, 0, G_OPTION_ARG_INT, &options.iterations, "Iterations of repeatable benchmarks", "N" },
+      { "xsl", 0, 0, G_OPTION_ARG_FILENAME, &xsl_file, "Stylesheet for HTML export", "FILE" },
+      { NULL, 0, 0, (GOptionArg)0, NULL, NULL, NULL }
+    };
+
+  GOptionContext *context = g_option_context_new(NULL);
+  g_option_context_add_main_entries(context, entries, NULL);
+  GError *error = NULL;
+  bool ok = g_option_context_parse(context, &argc, &argv, &error);
+  g_option_context_free(context);
+  if(!ok) {
+    std::fprintf(stderr, "%s\n", error->message);
+    g_error_free(error);
+    return false;
+  }
+
+  options.corpus.notes = std::max(notes, 1);
+  options.corpus.paragraphs = std::max(paragraphs, 0);
+  options.corpus.words_per_paragraph = std::max(words, 1);
+  options.corpus.tags = std::max(tags, 0);
+  options.corpus.tags_per_note = std::max(tags_per_note, 0);
+  options.corpus.notebooks = std::max(notebooks, 0);
+  options.corpus.lists = !no_lists;
+  options.corpus.seed = seed;
+  options.iterations = std::max(options.iterations, 1);
+  if(xsl_file) {
+    options.xsl_file = xsl_file;
+    g_free(xsl_file);
+  }
+  return true;
+}
+
+
+Glib::ustring make_temp_dir()
+{
+  char temp_dir_tmpl[] = "/tmp/gnotebenchXXXXXX";
+  return g_mkdtemp(temp_dir_tmpl);
+}
+
+
+void write_notes(NoteManager & manager, const bench::Corpus & corpus)
+{
+  auto date = Glib::DateTime::create_utc(2026, 1, 1, 12, 0, 0);
+  unsigned index = 0;
+  for(auto & note : corpus.notes()) {
+    auto file = Glib::build_filename(manager.notes_dir(), Glib::ustring::compose("%1.note", index++));
+    gnote::NoteData data(gnote::NoteBase::url_from_path(file));
+    data.title() = note.title;
+    data.set_text(Glib::ustring(note.content));
+    data.create_date() = date;
+    data.set_change_date(date);
+    data.metadata_change_date() = date;
+    for(auto & name : note.tags) {
+      auto tag = manager.tag_manager().get_or_create_tag(name);
+      data.tags()[tag->normalized_name()] = tag;
+    }
+    if(!note.notebook.empty()) {
+      auto tag = manager.tag_manager().get_or_create_system_tag(gnote::notebooks::Notebook::NOTEBOOK_TAG_PREFIX + note.notebook);
+      data.tags()[tag->normalized_name()] = tag;
+    }
+    manager.note_archiver().write_file(file, data);
+  }
+}
+
+
+void bench_search(NoteManager & manager, const bench::Corpus & corpus, int iterations)
+{
+  gnote::Search search(manager);
+  auto queries = corpus.search_queries();
+  std::size_t hits = 0;
+  Timer timer;
+  for(int i = 0; i < iterations; ++i) {
+    hits = 0;
+    for(auto & query : queries) {
+      hits += search.search_notes(query, false, gnote::notebooks::Notebook::ORef()).size();
+    }
+  }
+  std::printf("search_ms=%.3f search_queries=%zu search_hits=%zu\n", timer.ms(iterations), queries.size(), hits);
+}
+
+
+void bench_trie(const NoteManager & manager, int iterations)
+{
+  std::vector<Glib::ustring> texts;
+  manager.for_each([&texts](gnote::NoteBase & note) {
+    texts.push_back(note.text_content());
+  });
+
+  std::unique_ptr<gnote::TrieTree<Glib::ustring>> trie;
+  Timer build_timer;
+  for(int i = 0; i < iterations; ++i) {
+    trie = std::make_unique<gnote::TrieTree<Glib::ustring>>(false);
+    manager.for_each([&trie](gnote::NoteBase & note) {
+      trie->add_keyword(note.get_title(), note.uri());
+    });
+    trie->compute_failure_graph();
+  }
+  double build_ms = build_timer.ms(iterations);
+
+  std::size_t hits = 0;
+  Timer match_timer;
+  for(int i = 0; i < iterations; ++i) {
+    hits = 0;
+    for(auto & text : texts) {
+      hits += trie->find_matches(text).size();
+    }
+  }
+  std::printf("trie_build_ms=%.3f trie_match_ms=%.3f trie_hits=%zu\n", build_ms, match_timer.ms(iterations), hits);
+}
+
+
+void bench_archiver_write(NoteManager & manager, int iterations)
+{
+  std::vector<Glib::ustring> written;
+  Timer timer;
+  for(int i = 0; i < iterations; ++i) {
+    written.clear();
+    manager.for_each([&manager, &written](gnote::NoteBase & note) {
+      written.push_back(manager.note_archiver().write_string(note.data()));
+    });
+  }
+  std::size_t bytes = 0;
+  for(auto & xml : written) {
+    bytes += xml.bytes();
+  }
+  std::printf("archiver_write_string_ms=%.3f archiver_bytes=%zu\n", timer.ms(iterations), bytes);
+}
+
+
+bool bench_html_export(NoteManager & manager, const Glib::ustring & xsl_file, const Glib::ustring & out_dir, int iterations)
+{
+  if(!Glib::file_test(xsl_file, Glib::FileTest::IS_REGULAR)) {
+    std::printf("html_export_skipped=1\n");
+    return true;
+  }
+  // same renderer as the export and preview plugins, only the stylesheet is not installed
+  gnote::html::note_xsl_file(xsl_file);
+  gnote::html::note_xsl();
+  auto out_file = Glib::build_filename(out_dir, "export.html");
+
+  Timer timer;
+  for(int i = 0; i < iterations; ++i) {
+    sharp::StreamWriter writer;
+    writer.init(out_file);
+    manager.for_each([&manager, &writer](gnote::NoteBase & note) {
+      Glib::ustring xml = manager.note_archiver().write_string(note.data());
+      auto args = gnote::html::note_xsl_args(note.get_title(), "", false, false);
+      writer.write(gnote::html::render_note_html(xml.raw(), args));
+    });
+    writer.close();
+  }
+  double ms = timer.ms(iterations);
+
+  GStatBuf st;
+  bool ok = g_stat(out_file.c_str(), &st) == 0 && st.st_size > 0;
+  std::printf("html_export_ms=%.3f html_bytes=%lld\n", ms, ok ? (long long)st.st_size : 0ll);
+  g_remove(out_file.c_str());
+  return ok;
+}
+
+
+bool bench_sync(test::Gnote & g, NoteManager & manager, const Glib::ustring & root)
+{
+  auto sync_dir = Glib::build_filename(root, "sync");
+  g_mkdir(sync_dir.c_str(), 0700);
+
+  test::SyncManager upload_sync(g, manager, sync_dir);
+  g.sync_manager(&upload_sync);
+  upload_sync.get_client(Glib::build_filename(root, "manifest1.xml"));
+  Timer upload_timer;
+  upload_sync.perform_synchronization(gnote::sync::SilentUI::create(g, manager));
+  double upload_ms = upload_timer.ms();
+
+  test::Gnote g2;
+  NoteManager manager2(Glib::build_filename(root, "notes2"), g2);
+  g2.notebook_manager(&manager2.notebook_manager());
+  test::SyncManager download_sync(g2, manager2, sync_dir);
+  g2.sync_manager(&download_sync);
+  download_sync.get_client(Glib::build_filename(root, "manifest2.xml"));
+  Timer download_timer;
+  download_sync.perform_synchronization(gnote::sync::SilentUI::create(g2, manager2));
+  double download_ms = download_timer.ms();
+
+  std::printf("sync_upload_ms=%.3f sync_download_ms=%.3f sync_downloaded=%zu\n", upload_ms, download_ms, manager2.note_count());
+  g.sync_manager(nullptr);
+  remove_dir(sync_dir);
+  return manager2.note_count() == manager.note_count();
+}
+
+
+// plain text buffer can not hold bullets, so lists are left out here
+void bench_buffer(const Options & options)
+{
+  if(!gtk_init_check()) {
+    std::printf("buffer_skipped=1\n");
+    return;
+  }
+  Gtk::init_gtkmm_internals();
+
+  bench::CorpusOptions corpus_options = options.corpus;
+  corpus_options.lists = false;
+  bench::Corpus corpus(corpus_options);
+  auto buffer = Gtk::TextBuffer::create(gnote::NoteTagTable::instance());
+
+  double deserialize_ms = 0, serialize_ms = 0;
+  std::size_t bytes = 0;
+  for(int i = 0; i < options.iterations; ++i) {
+    bytes = 0;
+    for(auto & note : corpus.notes()) {
+      buffer->set_text("");
+      Timer deserialize_timer;
+      gnote::NoteBufferArchiver::deserialize(buffer, note.content);
+      deserialize_ms += deserialize_timer.ms();
+      Timer serialize_timer;
+      bytes += gnote::NoteBufferArchiver::serialize(buffer).bytes();
+      serialize_ms += serialize_timer.ms();
+    }
+  }
+  std::printf("buffer_deserialize_ms=%.3f buffer_serialize_ms=%.3f buffer_bytes=%zu\n",
+              deserialize_ms / options.iterations, serialize_ms / options.iterations, bytes);
+}
+
+
+int run(const Options & options)
+{
+  bench::Corpus corpus(options.corpus);
+  auto root = make_temp_dir();
+  int ret = 0;
+  {
+    test::Gnote g;
+    NoteManager manager(Glib::build_filename(root, "notes"), g);
+    g.notebook_manager(&manager.notebook_manager());
+    Timer write_timer;
+    write_notes(manager, corpus);
+    std::printf("archiver_write_file_ms=%.3f\n", write_timer.ms());
+
+    Timer load_timer;
+    manager.load_notes();
+    std::printf("load_ms=%.3f loaded=%zu\n", load_timer.ms(), manager.note_count());
+    if(manager.note_count() != corpus.notes().size()) {
+      ret = 1;
+    }
+
+    bench_search(manager, corpus, options.iterations);
+    bench_trie(manager, options.iterations);
+    bench_archiver_write(manager, options.iterations);
+    if(!bench_html_export(manager, options.xsl_file, root, options.iterations)) {
+      ret = 1;
+    }
+    if(!bench_sync(g, manager, root)) {
+      ret = 1;
+    }
+  }
+  remove_dir(root);
+  return ret;
+}
+
+}
+
+
+int main(int argc, char **argv)
+{
+  Glib::init();
+  Gio::init();
+
+  Options options;
+  if(!parse_options(argc, argv, options)) {
+    return 2;
+  }
+  std::printf("notes=%u paragraphs=%u words=%u link_density=%.3f tags=%u notebooks=%u unicode=%.3f lists=%d seed=%llu iterations=%d\n",
+              options.corpus.notes, options.corpus.paragraphs, options.corpus.words_per_paragraph, options.corpus.link_density,
+              options.corpus.tags, options.corpus.notebooks, options.corpus.unicode_ratio, int(options.corpus.lists),
+              (unsigned long long)options.corpus.seed, options.iterations);
+
+  // GTK stays on the main thread
+  bench_buffer(options);
+
+  // sync waits for file copies completed in the main loop, like the unit tests
+  auto main_loop = Glib::MainLoop::create();
+  int ret = 0;
+  std::thread thread([&main_loop, &options, &ret]() {
+    ret = run(options);
+    main_loop->quit();
+  });
+  main_loop->run();
+  thread.join();
+  return ret;
+}
+
@@ -0,0 +1,114 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Compares gnote::Hash with std::hash on note URIs and titles, and lookups with cached hashes.
+// Usage: hash-bench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+#include "base/hash.hpp"
+
+
+namespace {
+
+template <typename F>
+double measure(int iterations, const F & func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; ++i) {
+    func();
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <typename Key, typename H>
+double measure_lookups(const std::vector<Key> & keys, int iterations)
+{
+  std::unordered_set<Key, H> set(keys.begin(), keys.end());
+  std::size_t found = 0;
+  double ms = measure(iterations, [&] {
+    for(const auto & key : keys) {
+      found += set.count(key);
+    }
+  });
+  if(found != keys.size() * iterations) {
+    std::fputs("lookup failed\n", stderr);
+  }
+  return ms;
+}
+
+}
+
+
+int main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+  if(iterations < 1) {
+    iterations = 1;
+  }
+
+  std::vector<Glib::ustring> keys;
+  std::vector<gnote::HashedString> hashed_keys;
+  for(unsigned i = 0; i < 10000; ++i) {
+    char uri[64];
+    std::snprintf(uri, sizeof(uri), "note://gnote/%08x-1b2c-4d5e-8f90-%012u", i * 2654435761u, i);
+    keys.push_back(uri);
+    hashed_keys.emplace_back(keys.back());
+    keys.push_back(Glib::ustring::compose("Note title number %1", i));
+    hashed_keys.emplace_back(keys.back());
+  }
+
+  std::size_t sink = 0;
+  std::hash<std::string> std_hash;
+  double std_ms = measure(iterations, [&] {
+    for(const auto & key : keys) {
+      sink += std_hash(key.raw());
+    }
+  });
+  gnote::Hash<Glib::ustring> gnote_hash;
+  double gnote_ms = measure(iterations, [&] {
+    for(const auto & key : keys) {
+      sink += gnote_hash(key);
+    }
+  });
+
+  struct StdHash
+  {
+    std::size_t operator()(const Glib::ustring & s) const noexcept
+      {
+        return std::hash<std::string>()(s.raw());
+      }
+  };
+  double std_lookup_ms = measure_lookups<Glib::ustring, StdHash>(keys, iterations);
+  double lookup_ms = measure_lookups<Glib::ustring, gnote::Hash<Glib::ustring>>(keys, iterations);
+  double cached_lookup_ms = measure_lookups<gnote::HashedString, gnote::Hash<gnote::HashedString>>(hashed_keys, iterations);
+
+  std::printf("keys=%zu iterations=%d sink=%zu\n", keys.size(), iterations, sink % 10);
+  std::printf("std_hash_ms=%.2f hash_ms=%.2f\n", std_ms, gnote_ms);
+  std::printf("std_lookup_ms=%.2f lookup_ms=%.2f cached_lookup_ms=%.2f\n", std_lookup_ms, lookup_ms, cached_lookup_ms);
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Compares NoteBase::parse_text_content with DOM based extraction over a directory of notes.
+// Usage: parse-text-content-bench [notes-dir] [iterations]
+// Notes directory defaults to the one of current user.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <glibmm/init.h>
+#include <giomm/init.h>
+
+#include "ignote.hpp"
+#include "notebase.hpp"
+#include "sharp/directory.hpp"
+#include "sharp/files.hpp"
+#include "sharp/xmlreader.hpp"
+
+
+namespace {
+
+Glib::ustring parse_text_content_dom(const Glib::ustring & content)
+{
+  xmlDocPtr doc = xmlParseDoc((const xmlChar*)content.c_str());
+  if(!doc) {
+    return "";
+  }
+
+  Glib::ustring ret;
+  sharp::XmlReader reader(doc);
+  while(reader.read()) {
+    switch(reader.get_node_type()) {
+    case XML_READER_TYPE_ELEMENT:
+      if(reader.get_name() == "list-item") {
+        ret += "\n";
+      }
+      break;
+    case XML_READER_TYPE_TEXT:
+    case XML_READER_TYPE_WHITESPACE:
+    case XML_READER_TYPE_SIGNIFICANT_WHITESPACE:
+      ret += reader.get_value();
+      break;
+    default:
+      break;
+    }
+  }
+
+  return ret;
+}
+
+std::vector<Glib::ustring> load_corpus(const Glib::ustring & dir)
+{
+  std::vector<Glib::ustring> corpus;
+  for(const auto & file : sharp::directory_get_files_with_ext(dir, ".note")) {
+    Glib::ustring text = sharp::file_read_all_text(file);
+    auto start = text.find("<note-content");
+    auto end = text.find("</note-content>");
+    if(start != Glib::ustring::npos && end != Glib::ustring::npos) {
+      corpus.push_back(text.substr(start, end - start + 15));
+    }
+  }
+  return corpus;
+}
+
+template <typename F>
+double measure(const std::vector<Glib::ustring> & corpus, int iterations, const F & func)
+{
+  std::size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; ++i) {
+    for(const auto & content : corpus) {
+      total += func(content).bytes();
+    }
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  if(total == 0) {
+    std::fputs("no text extracted\n", stderr);
+  }
+  return elapsed.count();
+}
+
+}
+
+
+int main(int argc, char **argv)
+{
+  Glib::init();
+  Gio::init();
+
+  Glib::ustring dir = argc > 1 ? argv[1] : gnote::IGnote::data_dir();
+  int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+  if(iterations < 1) {
+    iterations = 1;
+  }
+
+  auto corpus = load_corpus(dir);
+  if(corpus.empty()) {
+    std::printf("no notes found in %s\n", dir.c_str());
+    return 0;
+  }
+
+  std::size_t bytes = 0;
+  unsigned mismatches = 0;
+  for(const auto & content : corpus) {
+    bytes += content.bytes();
+    if(gnote::NoteBase::parse_text_content(content) != parse_text_content_dom(content)) {
+      ++mismatches;
+    }
+  }
+
+  double dom_ms = measure(corpus, iterations, parse_text_content_dom);
+  double stream_ms = measure(corpus, iterations, gnote::NoteBase::parse_text_content);
+  double mb = double(bytes) * iterations / (1024 * 1024);
+  std::printf("notes=%zu bytes=%zu iterations=%d\n", corpus.size(), bytes, iterations);
+  std::printf("dom_ms=%.2f dom_mb_per_s=%.2f\n", dom_ms, mb / (dom_ms / 1000));
+  std::printf("stream_ms=%.2f stream_mb_per_s=%.2f\n", stream_ms, mb / (stream_ms / 1000));
+  std::printf("mismatches=%u\n", mismatches);
+
+  return mismatches == 0 ? 0 : 1;
+}
+
@@ -0,0 +1,84 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Measures how ThreadPool scales with number of threads on small CPU bound tasks.
+// Usage: thread-pool-bench [tasks]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "threadpool.hpp"
+#include "base/hash.hpp"
+
+
+namespace {
+
+// roughly the cost of parsing or searching a small note
+std::uint64_t work(unsigned seed)
+{
+  char buffer[256];
+  for(unsigned i = 0; i < sizeof(buffer); ++i) {
+    buffer[i] = static_cast<char>(seed + i);
+  }
+  std::uint64_t h = seed;
+  for(unsigned i = 0; i < 200; ++i) {
+    h = gnote::hash_bytes(buffer, sizeof(buffer), h);
+  }
+  return h;
+}
+
+}
+
+
+int main(int argc, char **argv)
+{
+  int tasks = argc > 1 ? std::atoi(argv[1]) : 20000;
+  if(tasks < 1) {
+    tasks = 1;
+  }
+
+  double single_ms = 0;
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<unsigned> thread_counts;
+  for(unsigned threads = 1; threads < max_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(max_threads);
+
+  for(unsigned threads : thread_counts) {
+    gnote::ThreadPool pool(threads);
+    std::atomic<std::uint64_t> sink(0);
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < tasks; ++i) {
+      pool.submit([&sink, i] { sink += work(i); });
+    }
+    pool.wait_idle();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if(threads == 1) {
+      single_ms = elapsed.count();
+    }
+    std::printf("threads=%u tasks=%d ms=%.2f speedup=%.2f sink=%u\n",
+                threads, tasks, elapsed.count(), single_ms / elapsed.count(), unsigned(sink.load() & 1));
+  }
+
+  return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Compares utils::XmlEncoder and utils::XmlDecoder with their libxml based equivalents.
+// Usage: xml-encoder-bench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <glibmm/init.h>
+
+#include "utils.hpp"
+#include "sharp/xmlreader.hpp"
+#include "sharp/xmlwriter.hpp"
+
+
+namespace {
+
+Glib::ustring libxml_encode(const Glib::ustring & source)
+{
+  sharp::XmlWriter xml;
+  xml.write_start_element("", "x", "");
+  xml.write_string(source);
+  xml.write_end_element();
+  xml.close();
+  Glib::ustring result = xml.to_string();
+  Glib::ustring::size_type end_pos = result.find("</x>");
+  if(end_pos == result.npos) {
+    return "";
+  }
+  result.resize(end_pos);
+  return result.substr(3);
+}
+
+Glib::ustring libxml_decode(const Glib::ustring & source)
+{
+  Glib::ustring builder;
+  sharp::XmlReader xml;
+  xml.load_buffer(source);
+  while(xml.read()) {
+    switch(xml.get_node_type()) {
+    case XML_READER_TYPE_TEXT:
+    case XML_READER_TYPE_WHITESPACE:
+    case XML_READER_TYPE_SIGNIFICANT_WHITESPACE:
+      builder += xml.get_value();
+      break;
+    default:
+      break;
+    }
+  }
+  xml.close();
+  return builder;
+}
+
+template <typename F>
+double measure(const std::vector<Glib::ustring> & inputs, int iterations, const F & func)
+{
+  std::size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; ++i) {
+    for(const auto & input : inputs) {
+      total += func(input).bytes();
+    }
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  if(total == 0) {
+    std::fputs("no output produced\n", stderr);
+  }
+  return elapsed.count();
+}
+
+}
+
+
+int main(int argc, char **argv)
+{
+  Glib::init();
+
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+  if(iterations < 1) {
+    iterations = 1;
+  }
+
+  // typical inputs: search queries, note titles and note bodies
+  std::vector<Glib::ustring> plain = {
+    "meeting",
+    "shopping list",
+    "New Note 42",
+    "Start Here",
+    "Using Links in Gnote",
+    "☺ unicode title",
+  };
+  std::vector<Glib::ustring> special = {
+    "Tom & Jerry",
+    "a < b > c",
+    "\"quoted\" title",
+    "Notes & <ideas>",
+  };
+
+  std::vector<Glib::ustring> xml;
+  for(const auto & input : plain) {
+    xml.push_back("<note-content version=\"0.1\"><note-title>" + input + "</note-title>\n\n" + input + "</note-content>");
+  }
+  for(const auto & input : special) {
+    auto encoded = libxml_encode(input);
+    xml.push_back("<note-content version=\"0.1\"><note-title>" + encoded + "</note-title>\n\n" + encoded + "</note-content>");
+  }
+
+  unsigned mismatches = 0;
+  for(auto inputs : {&plain, &special}) {
+    for(const auto & input : *inputs) {
+      if(gnote::utils::XmlEncoder::encode(input) != libxml_encode(input)) {
+        ++mismatches;
+      }
+    }
+  }
+  for(const auto & input : xml) {
+    if(gnote::utils::XmlDecoder::decode(input) != libxml_decode(input)) {
+      ++mismatches;
+    }
+  }
+
+  std::printf("iterations=%d\n", iterations);
+  std::printf("encode_plain_libxml_ms=%.2f encode_plain_ms=%.2f\n",
+    measure(plain, iterations, libxml_encode), measure(plain, iterations, gnote::utils::XmlEncoder::encode));
+  std::printf("encode_special_libxml_ms=%.2f encode_special_ms=%.2f\n",
+    measure(special, iterations, libxml_encode), measure(special, iterations, gnote::utils::XmlEncoder::encode));
+  std::printf("decode_libxml_ms=%.2f decode_ms=%.2f\n",
+    measure(xml, iterations, libxml_decode), measure(xml, iterations, gnote::utils::XmlDecoder::decode));
+  std::printf("mismatches=%u\n", mismatches);
+
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,334 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+
+#include "changejournal.hpp"
+#include "debug.hpp"
+#include "notemanagerbase.hpp"
+#include "sharp/files.hpp"
+#include "sharp/xmlreader.hpp"
+#include "sharp/xmlwriter.hpp"
+#include "tracing.hpp"
+
+
+namespace gnote {
+
+namespace {
+
+const guint SAVE_TIMEOUT = 2000;
+// sequence numbers reserved with a single write
+const guint64 SEQ_RESERVE = 100;
+
+const char *CHANGE_TYPE_NAMES[] = {
+  "added",
+  "saved",
+  "renamed",
+  "deleted",
+  "tag-added",
+  "tag-removed",
+};
+
+bool change_type_from_name(const Glib::ustring & name, ChangeJournal::ChangeType & type)
+{
+  for(unsigned i = 0; i < G_N_ELEMENTS(CHANGE_TYPE_NAMES); ++i) {
+    if(name == CHANGE_TYPE_NAMES[i]) {
+      type = static_cast<ChangeJournal::ChangeType>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+
+
+const char *ChangeJournal::change_type_name(ChangeType type)
+{
+  return CHANGE_TYPE_NAMES[static_cast<int>(type)];
+}
+
+
+ChangeJournal::ChangeJournal(const Glib::ustring & file, std::size_t capacity)
+  : m_file(file)
+  , m_capacity(capacity)
+  , m_next_seq(1)
+  , m_reserved_seq(1)
+  , m_complete_since(0)
+  , m_dirty(false)
+  , m_save_pending(false)
+{
+  m_save_timeout.signal_timeout.connect([this] {
+    m_save_pending = false;
+    save();
+  });
+  load();
+}
+
+
+ChangeJournal::~ChangeJournal()
+{
+  // no more numbers are handed out, give back the unused ones, so that next start knows nothing was lost
+  if(m_reserved_seq != m_next_seq) {
+    m_reserved_seq = m_next_seq;
+    m_dirty = true;
+  }
+  try {
+    save();
+  }
+  catch(std::exception & e) {
+    ERR_OUT("Failed to save change journal: %s", e.what());
+  }
+}
+
+
+void ChangeJournal::connect(NoteManagerBase & manager)
+{
+  manager.signal_note_added.connect(sigc::mem_fun(*this, &ChangeJournal::on_note_added));
+  manager.signal_note_deleted.connect(sigc::mem_fun(*this, &ChangeJournal::on_note_deleted));
+  manager.signal_note_saved.connect(sigc::mem_fun(*this, &ChangeJournal::on_note_saved));
+  manager.signal_note_renamed.connect(sigc::mem_fun(*this, &ChangeJournal::on_note_renamed));
+  manager.for_each([this](NoteBase & note) {
+    connect_note(note);
+  });
+}
+
+
+void ChangeJournal::connect_note(NoteBase & note)
+{
+  note.signal_tag_added.connect(sigc::mem_fun(*this, &ChangeJournal::on_note_tag_added));
+  note.signal_tag_removed.connect(sigc::mem_fun(*this, &ChangeJournal::on_note_tag_removed));
+}
+
+
+guint64 ChangeJournal::record(ChangeType type, const Glib::ustring & uri, const Glib::ustring & detail)
+{
+  if(m_next_seq >= m_reserved_seq) {
+    // has to be on disk before anyone sees the number
+    m_reserved_seq = m_next_seq + SEQ_RESERVE;
+    m_dirty = true;
+    try {
+      save();
+    }
+    catch(std::exception & e) {
+      ERR_OUT("Failed to save change journal: %s", e.what());
+    }
+  }
+  if(m_changes.size() >= m_capacity) {
+    m_complete_since = m_changes.front().seq;
+    m_changes.pop_front();
+  }
+  guint64 seq = m_next_seq++;
+  m_changes.push_back(Change{seq, type, uri, detail});
+  m_dirty = true;
+  if(!m_save_pending) {
+    m_save_pending = true;
+    m_save_timeout.reset(SAVE_TIMEOUT);
+  }
+  signal_recorded(m_changes.back());
+  return seq;
+}
+
+
+bool ChangeJournal::get_changes_since(guint64 seq, std::vector<Change> & changes) const
+{
+  if(seq > last_seq()) {
+    // journal was lost or comes from elsewhere
+    return false;
+  }
+  // gaps in sequence numbers are normal
+  auto iter = std::upper_bound(m_changes.begin(), m_changes.end(), seq, [](guint64 s, const Change & change) {
+    return s < change.seq;
+  });
+  changes.insert(changes.end(), iter, m_changes.end());
+  return seq >= m_complete_since;
+}
+
+
+void ChangeJournal::load()
+{
+  if(!sharp::file_exists(m_file)) {
+    return;
+  }
+
+  guint64 last_seq = 0;
+  bool has_last_seq = false;
+  try {
+    sharp::XmlReader reader(m_file);
+    while(reader.read()) {
+      if(reader.get_node_type() != XML_READER_TYPE_ELEMENT) {
+        continue;
+      }
+      if(reader.get_name() == "changes") {
+        Glib::ustring next_seq = reader.get_attribute("next-seq");
+        if(!next_seq.empty()) {
+          m_next_seq = std::max<guint64>(m_next_seq, std::stoull(next_seq));
+        }
+        Glib::ustring last = reader.get_attribute("last-seq");
+        if(!last.empty()) {
+          last_seq = std::stoull(last);
+          has_last_seq = true;
+        }
+      }
+      else if(reader.get_name() == "change") {
+        Change change;
+        change.seq = std::stoull(reader.get_attribute("seq"));
+        if(!change_type_from_name(reader.get_attribute("type"), change.type)) {
+          // change is lost, clients that have not seen it must rescan
+          m_complete_since = std::max(m_complete_since, change.seq);
+          m_next_seq = std::max(m_next_seq, change.seq + 1);
+          continue;
+        }
+        change.uri = reader.get_attribute("uri");
+        change.detail = reader.get_attribute("detail");
+        if(!m_changes.empty() && m_changes.back().seq >= change.seq) {
+          // out of order or duplicate, dropped like unknown changes
+          m_complete_since = std::max(m_complete_since, change.seq);
+          continue;
+        }
+        if(m_changes.size() >= m_capacity) {
+          m_complete_since = std::max(m_complete_since, m_changes.front().seq);
+          m_changes.pop_front();
+        }
+        m_next_seq = std::max(m_next_seq, change.seq + 1);
+        m_changes.push_back(std::move(change));
+      }
+    }
+  }
+  catch(std::exception & e) {
+    ERR_OUT("Failed to read change journal %s: %s", m_file.c_str(), e.what());
+    // the rest of the journal is lost
+    m_complete_since = m_next_seq - 1;
+  }
+
+  if(m_changes.empty()) {
+    m_complete_since = std::max(m_complete_since, m_next_seq - 1);
+  }
+  else {
+    m_complete_since = std::max(m_complete_since, m_changes.front().seq - 1);
+  }
+  // reserved numbers were not given back, changes after the last saved one might be lost
+  if(has_last_seq && last_seq + 1 < m_next_seq) {
+    m_complete_since = m_next_seq - 1;
+  }
+  m_reserved_seq = m_next_seq;
+}
+
+
+void ChangeJournal::save()
+{
+  if(!m_dirty) {
+    return;
+  }
+
+  TRACE_OP(FILE_WRITE);
+  Glib::ustring tmp_file = m_file + ".tmp";
+  {
+    sharp::XmlWriter xml(tmp_file);
+    try {
+      xml.write_start_document();
+      xml.write_start_element("", "changes", "");
+      xml.write_attribute_string("", "next-seq", "", TO_STRING(m_reserved_seq));
+      xml.write_attribute_string("", "last-seq", "", TO_STRING(last_seq()));
+      for(const auto & change : m_changes) {
+        xml.write_start_element("", "change", "");
+        xml.write_attribute_string("", "seq", "", TO_STRING(change.seq));
+        xml.write_attribute_string("", "type", "", change_type_name(change.type));
+        xml.write_attribute_string("", "uri", "", change.uri);
+        xml.write_attribute_string("", "detail", "", change.detail);
+        xml.write_end_element();
+      }
+      xml.write_end_element();
+      xml.write_end_document();
+      xml.close();
+    }
+    catch(...) {
+      xml.close();
+      throw;
+    }
+  }
+  sharp::file_move(tmp_file, m_file);
+  m_dirty = false;
+}
+
+
+void ChangeJournal::on_note_added(NoteBase & note)
+{
+  connect_note(note);
+  record(ChangeType::ADDED, note.uri(), note.get_title());
+}
+
+
+void ChangeJournal::on_note_deleted(NoteBase & note)
+{
+  record(ChangeType::DELETED, note.uri(), note.get_title());
+}
+
+
+void ChangeJournal::on_note_saved(NoteBase & note)
+{
+  record(ChangeType::SAVED, note.uri(), note.get_title());
+}
+
+
+void ChangeJournal::on_note_renamed(const NoteBase & note, const Glib::ustring &)
+{
+  record(ChangeType::RENAMED, note.uri(), note.get_title());
+}
+
+
+void ChangeJournal::on_note_tag_added(const NoteBase & note, const Tag::Ptr & tag)
+{
+  record(ChangeType::TAG_ADDED, note.uri(), tag->normalized_name());
+}
+
+
+void ChangeJournal::on_note_tag_removed(const NoteBase & note, const Glib::ustring & tag_name)
+{
+  record(ChangeType::TAG_REMOVED, note.uri(), tag_name);
+}
+
+
+void ChangeBatch::add(const ChangeJournal::Change & change)
+{
+  auto key = std::make_pair(change.uri, change.type);
+  auto iter = m_index.find(key);
+  if(iter != m_index.end()) {
+    m_changes[iter->second] = change;
+  }
+  else {
+    m_index.emplace(std::move(key), m_changes.size());
+    m_changes.push_back(change);
+  }
+}
+
+
+std::vector<ChangeJournal::Change> ChangeBatch::take()
+{
+  std::vector<ChangeJournal::Change> changes;
+  changes.swap(m_changes);
+  m_index.clear();
+  std::sort(changes.begin(), changes.end(), [](const ChangeJournal::Change & a, const ChangeJournal::Change & b) {
+    return a.seq < b.seq;
+  });
+  return changes;
+}
+
+}
@@ -0,0 +1,132 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _CHANGEJOURNAL_HPP_
+#define _CHANGEJOURNAL_HPP_
+
+#include <deque>
+#include <map>
+#include <vector>
+
+#include <glibmm/ustring.h>
+#include <sigc++/trackable.h>
+
+#include "tag.hpp"
+#include "utils.hpp"
+
+
+namespace gnote {
+
+class NoteBase;
+class NoteManagerBase;
+
+
+/// Bounded log of note changes with increasing sequence numbers, persisted to a file.
+/// Lets external clients catch up on changes made while they were not running.
+/// Sequence numbers are reserved on disk in blocks before being handed out, so they are never
+/// reused after a crash. They may have gaps.
+class ChangeJournal
+  : public sigc::trackable
+{
+public:
+  static const std::size_t DEFAULT_CAPACITY = 1000;
+
+  enum class ChangeType
+  {
+    ADDED,
+    SAVED,
+    RENAMED,
+    DELETED,
+    TAG_ADDED,
+    TAG_REMOVED,
+  };
+
+  struct Change
+  {
+    guint64 seq;
+    ChangeType type;
+    Glib::ustring uri;
+    // note title or tag name for tag changes
+    Glib::ustring detail;
+  };
+
+  static const char *change_type_name(ChangeType type);
+
+  ChangeJournal(const Glib::ustring & file, std::size_t capacity = DEFAULT_CAPACITY);
+  ~ChangeJournal();
+
+  void connect(NoteManagerBase & manager);
+  guint64 record(ChangeType type, const Glib::ustring & uri, const Glib::ustring & detail);
+  /// Appends changes with sequence number greater than seq.
+  /// Returns false if some of those changes are no longer in the journal or were lost in a crash,
+  /// client has to do full rescan then.
+  bool get_changes_since(guint64 seq, std::vector<Change> & changes) const;
+  guint64 last_seq() const
+    {
+      return m_next_seq - 1;
+    }
+  void save();
+
+  /// Emitted for every change recorded after load.
+  sigc::signal<void(const Change &)> signal_recorded;
+private:
+  void load();
+  void connect_note(NoteBase & note);
+  void on_note_added(NoteBase & note);
+  void on_note_deleted(NoteBase & note);
+  void on_note_saved(NoteBase & note);
+  void on_note_renamed(const NoteBase & note, const Glib::ustring & old_title);
+  void on_note_tag_added(const NoteBase & note, const Tag::Ptr & tag);
+  void on_note_tag_removed(const NoteBase & note, const Glib::ustring & tag_name);
+
+  Glib::ustring m_file;
+  std::size_t m_capacity;
+  std::deque<Change> m_changes;
+  guint64 m_next_seq;
+  // sequence numbers below this one are known to be unused on disk
+  guint64 m_reserved_seq;
+  // all changes after this one are in the journal
+  guint64 m_complete_since;
+  bool m_dirty;
+  bool m_save_pending;
+  utils::InterruptableTimeout m_save_timeout;
+};
+
+
+/// Collects changes to be announced together, keeping only the latest change of each type per note.
+class ChangeBatch
+{
+public:
+  void add(const ChangeJournal::Change & change);
+  bool empty() const
+    {
+      return m_changes.empty();
+    }
+  /// Returns collected changes ordered by sequence number and empties the batch.
+  std::vector<ChangeJournal::Change> take();
+private:
+  std::vector<ChangeJournal::Change> m_changes;
+  std::map<std::pair<Glib::ustring, ChangeJournal::ChangeType>, std::size_t> m_index;
+};
+
+}
+
+#endif
+
@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011,2017,2020,2022 Aurimas Cernius
  *
  * This program is free software: you can redistribute it and/or modify
@@ -17,14 +18,142 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <gio/gio.h>
+#include <glib/gstdio.h>
 #include <giomm/dbuserror.h>
+#include <giomm/dbusmessage.h>
 
 #include "debug.hpp"
 #include "remotecontrol-glue.hpp"
 
 using namespace org::gnome::Gnote;
 
+namespace {
+
+const off_t MAX_CONTENTS_SIZE = 64 * 1024 * 1024;
+
+// Anonymous file to pass note contents to clients, memfd can be sealed so client can map it safely
+int create_contents_fd()
+{
+  int fd = -1;
+#if defined(MFD_CLOEXEC) && defined(MFD_ALLOW_SEALING)
+  fd = memfd_create("gnote-note", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#endif
+  if(fd < 0) {
+    char *name = NULL;
+    fd = g_file_open_tmp("gnote-note-XXXXXX", &name, NULL);
+    if(name) {
+      g_unlink(name);
+      g_free(name);
+    }
+  }
+  if(fd < 0) {
+    throw std::runtime_error("Failed to create file for note contents");
+  }
+  return fd;
+}
+
+
+void write_contents(int fd, const char *data, gsize size)
+{
+  while(size > 0) {
+    ssize_t written = write(fd, data, size);
+    if(written < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(std::string("Failed to write note contents: ") + std::strerror(errno));
+    }
+    data += written;
+    size -= written;
+  }
+}
+
+
+void finish_contents_fd(int fd)
+{
+#ifdef F_ADD_SEALS
+  // fails for files not created by memfd_create, which is fine
+  fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+#endif
+  lseek(fd, 0, SEEK_SET);
+}
+
+
+Glib::VariantBase create_handle(const Glib::RefPtr<Gio::UnixFDList> & fd_list, int fd)
+{
+  int index;
+  try {
+    index = fd_list->append(fd);
+  }
+  catch(...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+  return Glib::VariantBase(g_variant_ref_sink(g_variant_new_handle(index)));
+}
+
+
+Glib::ustring read_contents(const Glib::VariantContainerBase & parameters, gsize child, const Glib::RefPtr<Gio::UnixFDList> & fd_list)
+{
+  if(!fd_list) {
+    throw std::runtime_error("No file descriptors passed");
+  }
+  Glib::VariantBase handle;
+  parameters.get_child(handle, child);
+  int fd = fd_list->get(g_variant_get_handle(handle.gobj()));
+
+  // only regular files and memfds, pipes and sockets could block main loop forever or never end
+  struct stat st;
+  if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    throw std::runtime_error("Note contents must be passed as regular file or memfd");
+  }
+  if(st.st_size > MAX_CONTENTS_SIZE) {
+    close(fd);
+    throw std::runtime_error("Note contents is too large");
+  }
+
+  // file can still grow while reading, never read more than it had
+  std::string contents(st.st_size, '\0');
+  gsize size = 0;
+  while(size < contents.size()) {
+    ssize_t count = pread(fd, &contents[size], contents.size() - size, size);
+    if(count < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      int err = errno;
+      close(fd);
+      throw std::runtime_error(std::string("Failed to read note contents: ") + std::strerror(err));
+    }
+    if(count == 0) {
+      break;
+    }
+    size += count;
+  }
+  close(fd);
+  contents.resize(size);
+
+  Glib::ustring result(std::move(contents));
+  if(!result.validate()) {
+    throw std::runtime_error("Note contents is not valid UTF-8");
+  }
+  return result;
+}
+
+}
+
 RemoteControl_adaptor::RemoteControl_adaptor(const Glib::RefPtr<Gio::DBus::Connection> & conn,
                                              const char *object_path,
                                              const char *interface_name,
@@ -47,6 +176,8 @@ RemoteControl_adaptor::RemoteControl_adaptor(const Glib::RefPtr<Gio::DBus::Conne
   m_stubs["FindNote"] = &RemoteControl_adaptor::FindNote_stub;
   m_stubs["FindStartHereNote"] = &RemoteControl_adaptor::FindStartHereNote_stub;
   m_stubs["GetAllNotesWithTag"] = &RemoteControl_adaptor::GetAllNotesWithTag_stub;
+  m_stubs["GetChangesSince"] = &RemoteControl_adaptor::GetChangesSince_stub;
+  m_stubs["GetMemoryUsage"] = &RemoteControl_adaptor::GetMemoryUsage_stub;
   m_stubs["GetNoteChangeDate"] = &RemoteControl_adaptor::GetNoteChangeDate_stub;
   m_stubs["GetNoteChangeDateUnix"] = &RemoteControl_adaptor::GetNoteChangeDateUnix_stub;
   m_stubs["GetNoteCompleteXml"] = &RemoteControl_adaptor::GetNoteCompleteXml_stub;
@@ -54,17 +185,26 @@ RemoteControl_adaptor::RemoteControl_adaptor(const Glib::RefPtr<Gio::DBus::Conne
   m_stubs["GetNoteContentsXml"] = &RemoteControl_adaptor::GetNoteContentsXml_stub;
   m_stubs["GetNoteCreateDate"] = &RemoteControl_adaptor::GetNoteCreateDate_stub;
   m_stubs["GetNoteCreateDateUnix"] = &RemoteControl_adaptor::GetNoteCreateDateUnix_stub;
+  m_stubs["GetNotesMetadata"] = &RemoteControl_adaptor::GetNotesMetadata_stub;
   m_stubs["GetNoteTitle"] = &RemoteControl_adaptor::GetNoteTitle_stub;
   m_stubs["GetTagsForNote"] = &RemoteControl_adaptor::GetTagsForNote_stub;
   m_stubs["HideNote"] = &RemoteControl_adaptor::HideNote_stub;
   m_stubs["ListAllNotes"] = &RemoteControl_adaptor::ListAllNotes_stub;
+  m_stubs["ListAllNotesWithMetadata"] = &RemoteControl_adaptor::ListAllNotesWithMetadata_stub;
   m_stubs["NoteExists"] = &RemoteControl_adaptor::NoteExists_stub;
   m_stubs["RemoveTagFromNote"] = &RemoteControl_adaptor::RemoveTagFromNote_stub;
   m_stubs["SearchNotes"] = &RemoteControl_adaptor::SearchNotes_stub;
+  m_stubs["SearchNotesPaged"] = &RemoteControl_adaptor::SearchNotesPaged_stub;
   m_stubs["SetNoteCompleteXml"] = &RemoteControl_adaptor::SetNoteCompleteXml_stub;
   m_stubs["SetNoteContents"] = &RemoteControl_adaptor::SetNoteContents_stub;
   m_stubs["SetNoteContentsXml"] = &RemoteControl_adaptor::SetNoteContentsXml_stub;
   m_stubs["Version"] = &RemoteControl_adaptor::Version_stub;
+
+  m_fd_stubs["GetNoteCompleteXmlFd"] = &RemoteControl_adaptor::GetNoteCompleteXmlFd_stub;
+  m_fd_stubs["GetNoteContentsXmlFd"] = &RemoteControl_adaptor::GetNoteContentsXmlFd_stub;
+  m_fd_stubs["GetNotesCompleteXmlFd"] = &RemoteControl_adaptor::GetNotesCompleteXmlFd_stub;
+  m_fd_stubs["SetNoteCompleteXmlFd"] = &RemoteControl_adaptor::SetNoteCompleteXmlFd_stub;
+  m_fd_stubs["SetNoteContentsXmlFd"] = &RemoteControl_adaptor::SetNoteContentsXmlFd_stub;
 }
 
 void RemoteControl_adaptor::NoteAdded(const Glib::ustring & uri)
@@ -85,6 +225,12 @@ void RemoteControl_adaptor::NoteSaved(const Glib::ustring & uri)
   emit_signal("NoteSaved", Glib::VariantContainerBase::create_tuple(Glib::Variant<Glib::ustring>::create(uri)));
 }
 
+void RemoteControl_adaptor::NotesChanged(const std::vector<std::tuple<Glib::ustring, Glib::ustring, guint64>> & changes)
+{
+  emit_signal("NotesChanged", Glib::VariantContainerBase::create_tuple(
+    Glib::Variant<std::vector<std::tuple<Glib::ustring, Glib::ustring, guint64>>>::create(changes)));
+}
+
 void RemoteControl_adaptor::on_method_call(const Glib::RefPtr<Gio::DBus::Connection> &,
                                            const Glib::ustring &,
                                            const Glib::ustring &,
@@ -93,6 +239,24 @@ void RemoteControl_adaptor::on_method_call(const Glib::RefPtr<Gio::DBus::Connect
                                            const Glib::VariantContainerBase & parameters,
                                            const Glib::RefPtr<Gio::DBus::MethodInvocation> & invocation)
 {
+  auto fd_iter = m_fd_stubs.find(method_name);
+  if(fd_iter != m_fd_stubs.end()) {
+    try {
+      Glib::RefPtr<Gio::UnixFDList> out_fds;
+      auto result = (this->*fd_iter->second)(parameters, invocation->get_message()->get_unix_fd_list(), out_fds);
+      invocation->return_value(result, out_fds);
+    }
+    catch(std::exception & e) {
+      invocation->return_error(Gio::DBus::Error(Gio::DBus::Error::FAILED,
+                               "Exception in method " + method_name + ": " + e.what()));
+    }
+    catch(Glib::Error & e) {
+      invocation->return_error(Gio::DBus::Error(Gio::DBus::Error::FAILED,
+                               "Exception in method " + method_name + ": " + e.what()));
+    }
+    return;
+  }
+
   std::map<Glib::ustring, stub_func>::iterator iter = m_stubs.find(method_name);
   if(iter == m_stubs.end()) {
     invocation->return_error(Gio::DBus::Error(Gio::DBus::Error::UNKNOWN_METHOD,
@@ -190,6 +354,31 @@ Glib::VariantContainerBase RemoteControl_adaptor::GetAllNotesWithTag_stub(const
 }
 
 
+Glib::VariantContainerBase RemoteControl_adaptor::GetChangesSince_stub(const Glib::VariantContainerBase & parameters)
+{
+  std::vector<std::tuple<guint64, Glib::ustring, Glib::ustring, Glib::ustring>> changes;
+  guint64 last_seq = 0;
+  bool complete = false;
+  if(parameters.get_n_children() == 1) {
+    Glib::Variant<guint64> param;
+    parameters.get_child(param);
+    complete = GetChangesSince(param.get(), changes, last_seq);
+  }
+
+  std::vector<Glib::VariantBase> result;
+  result.push_back(Glib::Variant<std::vector<std::tuple<guint64, Glib::ustring, Glib::ustring, Glib::ustring>>>::create(changes));
+  result.push_back(Glib::Variant<guint64>::create(last_seq));
+  result.push_back(Glib::Variant<bool>::create(complete));
+  return Glib::VariantContainerBase::create_tuple(result);
+}
+
+
+Glib::VariantContainerBase RemoteControl_adaptor::GetMemoryUsage_stub(const Glib::VariantContainerBase &)
+{
+  return Glib::VariantContainerBase::create_tuple(Glib::Variant<std::map<Glib::ustring, gint64>>::create(GetMemoryUsage()));
+}
+
+
 Glib::VariantContainerBase RemoteControl_adaptor::GetNoteChangeDate_stub(const Glib::VariantContainerBase & parameters)
 {
   return stub_int_string(parameters, &RemoteControl_adaptor::GetNoteChangeDate);
@@ -232,6 +421,20 @@ Glib::VariantContainerBase RemoteControl_adaptor::GetNoteCreateDateUnix_stub(con
 }
 
 
+Glib::VariantContainerBase RemoteControl_adaptor::GetNotesMetadata_stub(const Glib::VariantContainerBase & parameters)
+{
+  std::vector<std::map<Glib::ustring, Glib::VariantBase>> result;
+  if(parameters.get_n_children() == 1) {
+    Glib::Variant<std::vector<Glib::ustring>> param;
+    parameters.get_child(param);
+    result = GetNotesMetadata(param.get());
+  }
+
+  return Glib::VariantContainerBase::create_tuple(
+    Glib::Variant<std::vector<std::map<Glib::ustring, Glib::VariantBase>>>::create(result));
+}
+
+
 Glib::VariantContainerBase RemoteControl_adaptor::GetNoteTitle_stub(const Glib::VariantContainerBase & parameters)
 {
   return stub_string_string(parameters, &RemoteControl_adaptor::GetNoteTitle);
@@ -256,6 +459,13 @@ Glib::VariantContainerBase RemoteControl_adaptor::ListAllNotes_stub(const Glib::
 }
 
 
+Glib::VariantContainerBase RemoteControl_adaptor::ListAllNotesWithMetadata_stub(const Glib::VariantContainerBase &)
+{
+  return Glib::VariantContainerBase::create_tuple(
+    Glib::Variant<std::vector<std::map<Glib::ustring, Glib::VariantBase>>>::create(ListAllNotesWithMetadata()));
+}
+
+
 Glib::VariantContainerBase RemoteControl_adaptor::NoteExists_stub(const Glib::VariantContainerBase & parameters)
 {
   return stub_bool_string(parameters, &RemoteControl_adaptor::NoteExists);
@@ -274,6 +484,29 @@ Glib::VariantContainerBase RemoteControl_adaptor::SearchNotes_stub(const Glib::V
 }
 
 
+Glib::VariantContainerBase RemoteControl_adaptor::SearchNotesPaged_stub(const Glib::VariantContainerBase & parameters)
+{
+  std::vector<std::tuple<Glib::ustring, gint32>> results;
+  guint32 total = 0;
+  if(parameters.get_n_children() == 4) {
+    Glib::Variant<Glib::ustring> query;
+    parameters.get_child(query, 0);
+    Glib::Variant<bool> case_sensitive;
+    parameters.get_child(case_sensitive, 1);
+    Glib::Variant<guint32> offset;
+    parameters.get_child(offset, 2);
+    Glib::Variant<guint32> limit;
+    parameters.get_child(limit, 3);
+    total = SearchNotesPaged(query.get(), case_sensitive.get(), offset.get(), limit.get(), results);
+  }
+
+  std::vector<Glib::VariantBase> result;
+  result.push_back(Glib::Variant<std::vector<std::tuple<Glib::ustring, gint32>>>::create(results));
+  result.push_back(Glib::Variant<guint32>::create(total));
+  return Glib::VariantContainerBase::create_tuple(result);
+}
+
+
 Glib::VariantContainerBase RemoteControl_adaptor::SetNoteCompleteXml_stub(const Glib::VariantContainerBase & parameters)
 {
   return stub_bool_string_string(parameters, &RemoteControl_adaptor::SetNoteCompleteXml);
@@ -298,6 +531,78 @@ Glib::VariantContainerBase RemoteControl_adaptor::Version_stub(const Glib::Varia
 }
 
 
+Glib::VariantContainerBase RemoteControl_adaptor::GetNoteCompleteXmlFd_stub(const Glib::VariantContainerBase & parameters,
+                                                                          const Glib::RefPtr<Gio::UnixFDList> &,
+                                                                          Glib::RefPtr<Gio::UnixFDList> & out_fds)
+{
+  return stub_fd_string(parameters, out_fds, &RemoteControl_adaptor::GetNoteCompleteXml);
+}
+
+
+Glib::VariantContainerBase RemoteControl_adaptor::GetNoteContentsXmlFd_stub(const Glib::VariantContainerBase & parameters,
+                                                                          const Glib::RefPtr<Gio::UnixFDList> &,
+                                                                          Glib::RefPtr<Gio::UnixFDList> & out_fds)
+{
+  return stub_fd_string(parameters, out_fds, &RemoteControl_adaptor::GetNoteContentsXml);
+}
+
+
+Glib::VariantContainerBase RemoteControl_adaptor::GetNotesCompleteXmlFd_stub(const Glib::VariantContainerBase & parameters,
+                                                                           const Glib::RefPtr<Gio::UnixFDList> &,
+                                                                           Glib::RefPtr<Gio::UnixFDList> & out_fds)
+{
+  std::vector<Glib::ustring> uris;
+  if(parameters.get_n_children() == 1) {
+    Glib::Variant<std::vector<Glib::ustring>> param;
+    parameters.get_child(param);
+    uris = param.get();
+  }
+
+  // all notes go into one file, offset table tells where each one is
+  std::vector<std::tuple<Glib::ustring, guint64, guint64>> offsets;
+  int fd = create_contents_fd();
+  try {
+    guint64 offset = 0;
+    for(const auto & uri : uris) {
+      Glib::ustring xml = GetNoteCompleteXml(uri);
+      if(xml.empty()) {
+        continue;
+      }
+      write_contents(fd, xml.data(), xml.bytes());
+      offsets.emplace_back(uri, offset, xml.bytes());
+      offset += xml.bytes();
+    }
+    finish_contents_fd(fd);
+  }
+  catch(...) {
+    close(fd);
+    throw;
+  }
+
+  out_fds = Gio::UnixFDList::create();
+  std::vector<Glib::VariantBase> result;
+  result.push_back(create_handle(out_fds, fd));
+  result.push_back(Glib::Variant<std::vector<std::tuple<Glib::ustring, guint64, guint64>>>::create(offsets));
+  return Glib::VariantContainerBase::create_tuple(result);
+}
+
+
+Glib::VariantContainerBase RemoteControl_adaptor::SetNoteCompleteXmlFd_stub(const Glib::VariantContainerBase & parameters,
+                                                                          const Glib::RefPtr<Gio::UnixFDList> & in_fds,
+                                                                          Glib::RefPtr<Gio::UnixFDList> &)
+{
+  return stub_bool_string_fd(parameters, in_fds, &RemoteControl_adaptor::SetNoteCompleteXml);
+}
+
+
+Glib::VariantContainerBase RemoteControl_adaptor::SetNoteContentsXmlFd_stub(const Glib::VariantContainerBase & parameters,
+                                                                          const Glib::RefPtr<Gio::UnixFDList> & in_fds,
+                                                                          Glib::RefPtr<Gio::UnixFDList> &)
+{
+  return stub_bool_string_fd(parameters, in_fds, &RemoteControl_adaptor::SetNoteContentsXml);
+}
+
+
 Glib::VariantContainerBase RemoteControl_adaptor::stub_void_string(const Glib::VariantContainerBase & parameters,
                                                                    void_string_func func)
 {
@@ -419,3 +724,43 @@ Glib::VariantContainerBase RemoteControl_adaptor::stub_vectorstring_string_bool(
   return Glib::VariantContainerBase::create_tuple(Glib::Variant<std::vector<Glib::ustring> >::create(result));
 }
 
+
+Glib::VariantContainerBase RemoteControl_adaptor::stub_fd_string(const Glib::VariantContainerBase & parameters,
+                                                                 Glib::RefPtr<Gio::UnixFDList> & out_fds,
+                                                                 string_string_func func)
+{
+  Glib::ustring result;
+  if(parameters.get_n_children() == 1) {
+    Glib::Variant<Glib::ustring> param;
+    parameters.get_child(param);
+    result = (this->*func)(param.get());
+  }
+
+  int fd = create_contents_fd();
+  try {
+    write_contents(fd, result.data(), result.bytes());
+    finish_contents_fd(fd);
+  }
+  catch(...) {
+    close(fd);
+    throw;
+  }
+
+  out_fds = Gio::UnixFDList::create();
+  return Glib::VariantContainerBase::create_tuple(create_handle(out_fds, fd));
+}
+
+
+Glib::VariantContainerBase RemoteControl_adaptor::stub_bool_string_fd(const Glib::VariantContainerBase & parameters,
+                                                                      const Glib::RefPtr<Gio::UnixFDList> & in_fds,
+                                                                      bool_string_string_func func)
+{
+  bool result = false;
+  if(parameters.get_n_children() == 2) {
+    Glib::Variant<Glib::ustring> param1;
+    parameters.get_child(param1, 0);
+    result = (this->*func)(param1.get(), read_contents(parameters, 1, in_fds));
+  }
+
+  return Glib::VariantContainerBase::create_tuple(Glib::Variant<bool>::create(result));
+}
@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011,2017,2020 Aurimas Cernius
  *
  * This program is free software: you can redistribute it and/or modify
@@ -18,8 +19,12 @@
  */
 
 
+#include <map>
+#include <tuple>
+
 #include <giomm/dbusconnection.h>
 #include <giomm/dbusinterfacevtable.h>
+#include <giomm/unixfdlist.h>
 
 namespace org {
 namespace gnome {
@@ -44,6 +49,8 @@ public:
   virtual Glib::ustring FindNote(const Glib::ustring& linked_title) = 0;
   virtual Glib::ustring FindStartHereNote() = 0;
   virtual std::vector<Glib::ustring> GetAllNotesWithTag(const Glib::ustring& tag_name) = 0;
+  virtual bool GetChangesSince(guint64 seq, std::vector<std::tuple<guint64, Glib::ustring, Glib::ustring, Glib::ustring>> & changes, guint64 & last_seq) = 0;
+  virtual std::map<Glib::ustring, gint64> GetMemoryUsage() = 0;
   virtual int32_t GetNoteChangeDate(const Glib::ustring& uri) = 0;
   virtual int64_t GetNoteChangeDateUnix(const Glib::ustring& uri) = 0;
   virtual Glib::ustring GetNoteCompleteXml(const Glib::ustring& uri) = 0;
@@ -51,13 +58,17 @@ public:
   virtual Glib::ustring GetNoteContentsXml(const Glib::ustring& uri) = 0;
   virtual int32_t GetNoteCreateDate(const Glib::ustring& uri) = 0;
   virtual int64_t GetNoteCreateDateUnix(const Glib::ustring& uri) = 0;
+  virtual std::vector<std::map<Glib::ustring, Glib::VariantBase>> GetNotesMetadata(const std::vector<Glib::ustring>& uris) = 0;
   virtual Glib::ustring GetNoteTitle(const Glib::ustring& uri) = 0;
   virtual std::vector<Glib::ustring> GetTagsForNote(const Glib::ustring& uri) = 0;
   virtual bool HideNote(const Glib::ustring& uri) = 0;
   virtual std::vector<Glib::ustring> ListAllNotes() = 0;
+  virtual std::vector<std::map<Glib::ustring, Glib::VariantBase>> ListAllNotesWithMetadata() = 0;
   virtual bool NoteExists(const Glib::ustring& uri) = 0;
   virtual bool RemoveTagFromNote(const Glib::ustring& uri, const Glib::ustring& tag_name) = 0;
   virtual std::vector<Glib::ustring> SearchNotes(const Glib::ustring& query, const bool& case_sensitive) = 0;
+  virtual guint32 SearchNotesPaged(const Glib::ustring& query, bool case_sensitive, guint32 offset, guint32 limit,
+                                   std::vector<std::tuple<Glib::ustring, gint32>> & results) = 0;
   virtual bool SetNoteCompleteXml(const Glib::ustring& uri, const Glib::ustring& xml_contents) = 0;
   virtual bool SetNoteContents(const Glib::ustring& uri, const Glib::ustring& text_contents) = 0;
   virtual bool SetNoteContentsXml(const Glib::ustring& uri, const Glib::ustring& xml_contents) = 0;
@@ -65,6 +76,7 @@ public:
   void NoteAdded(const Glib::ustring & );
   void NoteDeleted(const Glib::ustring &, const Glib::ustring &);
   void NoteSaved(const Glib::ustring &);
+  void NotesChanged(const std::vector<std::tuple<Glib::ustring, Glib::ustring, guint64>> &);
 private:
   void on_method_call(const Glib::RefPtr<Gio::DBus::Connection> & connection,
                       const Glib::ustring & sender,
@@ -86,6 +98,8 @@ private:
   Glib::VariantContainerBase FindNote_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase FindStartHereNote_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetAllNotesWithTag_stub(const Glib::VariantContainerBase &);
+  Glib::VariantContainerBase GetChangesSince_stub(const Glib::VariantContainerBase &);
+  Glib::VariantContainerBase GetMemoryUsage_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetNoteChangeDate_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetNoteChangeDateUnix_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetNoteCompleteXml_stub(const Glib::VariantContainerBase &);
@@ -93,18 +107,28 @@ private:
   Glib::VariantContainerBase GetNoteContentsXml_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetNoteCreateDate_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetNoteCreateDateUnix_stub(const Glib::VariantContainerBase &);
+  Glib::VariantContainerBase GetNotesMetadata_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetNoteTitle_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase GetTagsForNote_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase HideNote_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase ListAllNotes_stub(const Glib::VariantContainerBase &);
+  Glib::VariantContainerBase ListAllNotesWithMetadata_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase NoteExists_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase RemoveTagFromNote_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase SearchNotes_stub(const Glib::VariantContainerBase &);
+  Glib::VariantContainerBase SearchNotesPaged_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase SetNoteCompleteXml_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase SetNoteContents_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase SetNoteContentsXml_stub(const Glib::VariantContainerBase &);
   Glib::VariantContainerBase Version_stub(const Glib::VariantContainerBase &);
 
+  // methods passing note contents as file descriptors
+  Glib::VariantContainerBase GetNoteCompleteXmlFd_stub(const Glib::VariantContainerBase &, const Glib::RefPtr<Gio::UnixFDList> &, Glib::RefPtr<Gio::UnixFDList> &);
+  Glib::VariantContainerBase GetNoteContentsXmlFd_stub(const Glib::VariantContainerBase &, const Glib::RefPtr<Gio::UnixFDList> &, Glib::RefPtr<Gio::UnixFDList> &);
+  Glib::VariantContainerBase GetNotesCompleteXmlFd_stub(const Glib::VariantContainerBase &, const Glib::RefPtr<Gio::UnixFDList> &, Glib::RefPtr<Gio::UnixFDList> &);
+  Glib::VariantContainerBase SetNoteCompleteXmlFd_stub(const Glib::VariantContainerBase &, const Glib::RefPtr<Gio::UnixFDList> &, Glib::RefPtr<Gio::UnixFDList> &);
+  Glib::VariantContainerBase SetNoteContentsXmlFd_stub(const Glib::VariantContainerBase &, const Glib::RefPtr<Gio::UnixFDList> &, Glib::RefPtr<Gio::UnixFDList> &);
+
   typedef void (RemoteControl_adaptor::*void_string_func)(const Glib::ustring &);
   Glib::VariantContainerBase stub_void_string(const Glib::VariantContainerBase &, void_string_func);
   typedef bool (RemoteControl_adaptor::*bool_string_func)(const Glib::ustring &);
@@ -124,8 +148,16 @@ private:
   typedef std::vector<Glib::ustring> (RemoteControl_adaptor::*vectorstring_string_bool_func)(const Glib::ustring &, const bool &);
   Glib::VariantContainerBase stub_vectorstring_string_bool(const Glib::VariantContainerBase &, vectorstring_string_bool_func);
 
+  Glib::VariantContainerBase stub_fd_string(const Glib::VariantContainerBase &, Glib::RefPtr<Gio::UnixFDList> &, string_string_func);
+  Glib::VariantContainerBase stub_bool_string_fd(const Glib::VariantContainerBase &, const Glib::RefPtr<Gio::UnixFDList> &,
+                                                 bool_string_string_func);
+
   typedef Glib::VariantContainerBase (RemoteControl_adaptor::*stub_func)(const Glib::VariantContainerBase &);
   std::map<Glib::ustring, stub_func> m_stubs;
+  typedef Glib::VariantContainerBase (RemoteControl_adaptor::*fd_stub_func)(const Glib::VariantContainerBase &,
+                                                                            const Glib::RefPtr<Gio::UnixFDList> &,
+                                                                            Glib::RefPtr<Gio::UnixFDList> &);
+  std::map<Glib::ustring, fd_stub_func> m_fd_stubs;
   Glib::RefPtr<Gio::DBus::Connection> m_connection;
   const char *m_path;
   const char *m_interface_name;
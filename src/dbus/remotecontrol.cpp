@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011-2014,2016-2017,2019-2020,2022-2023 Aurimas Cernius
  * Copyright (C) 2009 Hubert Figuiere
  *
@@ -18,18 +19,23 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <glibmm/i18n.h>
+#include <glibmm/miscutils.h>
 
 #include "config.h"
 
 #include "debug.hpp"
 #include "ignote.hpp"
+#include "memoryusage.hpp"
 #include "notemanager.hpp"
 #include "notewindow.hpp"
 #include "remotecontrolproxy.hpp"
 #include "search.hpp"
 #include "tag.hpp"
 #include "itagmanager.hpp"
+#include "notebooks/notebookmanager.hpp"
 #include "dbus/remotecontrol.hpp"
 #include "sharp/map.hpp"
 
@@ -42,6 +48,8 @@ namespace gnote {
     : IRemoteControl(cnx, path, interface_name, gnote_interface)
     , m_gnote(g)
     , m_manager(manager)
+    , m_journal(Glib::build_filename(manager.notes_dir(), "changes.xml"))
+    , m_search_cache(manager)
   {
     DBG_OUT("initialized remote control");
     m_manager.signal_note_added.connect(
@@ -50,6 +58,9 @@ namespace gnote {
       sigc::mem_fun(*this, &RemoteControl::on_note_deleted));
     m_manager.signal_note_saved.connect(
       sigc::mem_fun(*this, &RemoteControl::on_note_saved));
+    m_journal.connect(m_manager);
+    m_journal.signal_recorded.connect(sigc::mem_fun(*this, &RemoteControl::on_change_recorded));
+    m_notes_changed_timeout.signal_timeout.connect(sigc::mem_fun(*this, &RemoteControl::emit_notes_changed));
   }
 
 
@@ -165,6 +176,34 @@ namespace gnote {
   }
 
 
+  bool RemoteControl::GetChangesSince(guint64 seq, std::vector<std::tuple<guint64, Glib::ustring, Glib::ustring, Glib::ustring>> & changes, guint64 & last_seq)
+  {
+    std::vector<ChangeJournal::Change> journal_changes;
+    bool complete = m_journal.get_changes_since(seq, journal_changes);
+    changes.reserve(journal_changes.size());
+    for(auto & change : journal_changes) {
+      changes.emplace_back(change.seq, ChangeJournal::change_type_name(change.type), change.uri, change.detail);
+    }
+    last_seq = m_journal.last_seq();
+    return complete;
+  }
+
+
+  std::map<Glib::ustring, gint64> RemoteControl::GetMemoryUsage()
+  {
+    std::map<Glib::ustring, gint64> usage;
+    gint64 total = 0;
+    for(int i = 0; i < static_cast<int>(memory::Category::COUNT); ++i) {
+      auto category = static_cast<memory::Category>(i);
+      gint64 bytes = memory::usage(category);
+      usage[memory::category_name(category)] = bytes;
+      total += bytes;
+    }
+    usage["total"] = total;
+    return usage;
+  }
+
+
   int32_t RemoteControl::GetNoteChangeDate(const Glib::ustring& uri)
   {
     return GetNoteChangeDateUnix(uri);
@@ -227,6 +266,25 @@ namespace gnote {
   }
 
 
+  std::vector<std::map<Glib::ustring, Glib::VariantBase>> RemoteControl::GetNotesMetadata(const std::vector<Glib::ustring>& uris)
+  {
+    std::vector<std::map<Glib::ustring, Glib::VariantBase>> result;
+    result.reserve(uris.size());
+    for(const auto & uri : uris) {
+      if(auto note = m_manager.find_by_uri(uri)) {
+        result.push_back(get_note_metadata(note.value()));
+      }
+      else {
+        // keep results aligned with the requested uris
+        std::map<Glib::ustring, Glib::VariantBase> missing;
+        missing["uri"] = Glib::Variant<Glib::ustring>::create(uri);
+        result.push_back(std::move(missing));
+      }
+    }
+    return result;
+  }
+
+
   Glib::ustring RemoteControl::GetNoteTitle(const Glib::ustring& uri)
   {
     Glib::ustring title;
@@ -271,6 +329,17 @@ std::vector<Glib::ustring> RemoteControl::ListAllNotes()
 }
 
 
+std::vector<std::map<Glib::ustring, Glib::VariantBase>> RemoteControl::ListAllNotesWithMetadata()
+{
+  std::vector<std::map<Glib::ustring, Glib::VariantBase>> result;
+  result.reserve(m_manager.note_count());
+  m_manager.for_each([this, &result](const NoteBase & note) {
+    result.push_back(get_note_metadata(note));
+  });
+  return result;
+}
+
+
 bool RemoteControl::NoteExists(const Glib::ustring& uri)
 {
   return m_manager.find_by_uri(uri).has_value();
@@ -306,6 +375,23 @@ std::vector<Glib::ustring> RemoteControl::SearchNotes(const Glib::ustring& query
 }
 
 
+guint32 RemoteControl::SearchNotesPaged(const Glib::ustring& query, bool case_sensitive, guint32 offset, guint32 limit,
+                                        std::vector<std::tuple<Glib::ustring, gint32>> & results)
+{
+  if(query.empty()) {
+    return 0;
+  }
+
+  std::vector<SearchResultCache::Result> page;
+  guint32 total = m_search_cache.get_page(query, case_sensitive, offset, limit, page);
+  results.reserve(page.size());
+  for(auto & result : page) {
+    results.emplace_back(std::move(result.second), result.first);
+  }
+  return total;
+}
+
+
 bool RemoteControl::SetNoteCompleteXml(const Glib::ustring& uri, 
                                        const Glib::ustring& xml_contents)
 {
@@ -342,19 +428,49 @@ Glib::ustring RemoteControl::Version()
 
 void RemoteControl::on_note_added(NoteBase & note)
 {
-  NoteAdded(note.uri());
+  if(m_gnote.preferences().dbus_per_note_signals()) {
+    NoteAdded(note.uri());
+  }
 }
 
 
 void RemoteControl::on_note_deleted(NoteBase & note)
 {
-  NoteDeleted(note.uri(), note.get_title());
+  if(m_gnote.preferences().dbus_per_note_signals()) {
+    NoteDeleted(note.uri(), note.get_title());
+  }
 }
 
 
 void RemoteControl::on_note_saved(NoteBase & note)
 {
-  NoteSaved(note.uri());
+  if(m_gnote.preferences().dbus_per_note_signals()) {
+    NoteSaved(note.uri());
+  }
+}
+
+
+void RemoteControl::on_change_recorded(const ChangeJournal::Change & change)
+{
+  m_pending_changes.add(change);
+  // the timeout is not restarted, so that a steady stream of changes still gets announced every interval
+  if(!m_notes_changed_pending) {
+    m_notes_changed_pending = true;
+    m_notes_changed_timeout.reset(std::max(0, m_gnote.preferences().dbus_notes_changed_interval()));
+  }
+}
+
+
+void RemoteControl::emit_notes_changed()
+{
+  m_notes_changed_pending = false;
+  std::vector<std::tuple<Glib::ustring, Glib::ustring, guint64>> changes;
+  for(auto & change : m_pending_changes.take()) {
+    changes.emplace_back(std::move(change.uri), ChangeJournal::change_type_name(change.type), change.seq);
+  }
+  if(!changes.empty()) {
+    NotesChanged(changes);
+  }
 }
 
 
@@ -364,4 +480,29 @@ MainWindow & RemoteControl::present_note(NoteBase & note)
 }
 
 
+std::map<Glib::ustring, Glib::VariantBase> RemoteControl::get_note_metadata(const NoteBase & note)
+{
+  std::map<Glib::ustring, Glib::VariantBase> metadata;
+  metadata["uri"] = Glib::Variant<Glib::ustring>::create(note.uri());
+  metadata["title"] = Glib::Variant<Glib::ustring>::create(note.get_title());
+  metadata["create-date"] = Glib::Variant<gint64>::create(note.create_date().to_unix());
+  metadata["change-date"] = Glib::Variant<gint64>::create(note.change_date().to_unix());
+  metadata["metadata-change-date"] = Glib::Variant<gint64>::create(note.metadata_change_date().to_unix());
+
+  std::vector<Glib::ustring> tags;
+  Glib::ustring notebook;
+  for(auto & tag : note.get_tags()) {
+    tags.push_back(tag->normalized_name());
+    if(notebook.empty()) {
+      if(auto nb = m_gnote.notebook_manager().get_notebook_from_tag(tag)) {
+        notebook = nb.value().get().get_name();
+      }
+    }
+  }
+  metadata["tags"] = Glib::Variant<std::vector<Glib::ustring>>::create(tags);
+  metadata["notebook"] = Glib::Variant<Glib::ustring>::create(notebook);
+  return metadata;
+}
+
+
 }
@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011-2014,2017,2019-2020,2023 Aurimas Cernius
  * Copyright (C) 2009 Hubert Figuiere
  *
@@ -21,13 +22,16 @@
 #ifndef __GNOTE_REMOTECONTROL_HPP_
 #define __GNOTE_REMOTECONTROL_HPP_
 
+#include <map>
 #include <vector>
 
 #include <giomm/dbusconnection.h>
 
+#include "changejournal.hpp"
 #include "dbus/iremotecontrol.hpp"
 #include "mainwindow.hpp"
 #include "note.hpp"
+#include "search.hpp"
 
 
 namespace gnote {
@@ -54,6 +58,8 @@ public:
   virtual Glib::ustring FindNote(const Glib::ustring& linked_title) override;
   virtual Glib::ustring FindStartHereNote() override;
   virtual std::vector<Glib::ustring> GetAllNotesWithTag(const Glib::ustring& tag_name) override;
+  virtual bool GetChangesSince(guint64 seq, std::vector<std::tuple<guint64, Glib::ustring, Glib::ustring, Glib::ustring>> & changes, guint64 & last_seq) override;
+  virtual std::map<Glib::ustring, gint64> GetMemoryUsage() override;
   virtual int32_t GetNoteChangeDate(const Glib::ustring& uri) override;
   virtual int64_t GetNoteChangeDateUnix(const Glib::ustring& uri) override;
   virtual Glib::ustring GetNoteCompleteXml(const Glib::ustring& uri) override;
@@ -61,13 +67,17 @@ public:
   virtual Glib::ustring GetNoteContentsXml(const Glib::ustring& uri) override;
   virtual int32_t GetNoteCreateDate(const Glib::ustring& uri) override;
   virtual int64_t GetNoteCreateDateUnix(const Glib::ustring& uri) override;
+  virtual std::vector<std::map<Glib::ustring, Glib::VariantBase>> GetNotesMetadata(const std::vector<Glib::ustring>& uris) override;
   virtual Glib::ustring GetNoteTitle(const Glib::ustring& uri) override;
   virtual std::vector<Glib::ustring> GetTagsForNote(const Glib::ustring& uri) override;
   virtual bool HideNote(const Glib::ustring& uri) override;
   virtual std::vector<Glib::ustring> ListAllNotes() override;
+  virtual std::vector<std::map<Glib::ustring, Glib::VariantBase>> ListAllNotesWithMetadata() override;
   virtual bool NoteExists(const Glib::ustring& uri) override;
   virtual bool RemoveTagFromNote(const Glib::ustring& uri, const Glib::ustring& tag_name) override;
   virtual std::vector<Glib::ustring> SearchNotes(const Glib::ustring& query, const bool& case_sensitive) override;
+  virtual guint32 SearchNotesPaged(const Glib::ustring& query, bool case_sensitive, guint32 offset, guint32 limit,
+                                   std::vector<std::tuple<Glib::ustring, gint32>> & results) override;
   virtual bool SetNoteCompleteXml(const Glib::ustring& uri, const Glib::ustring& xml_contents) override;
   virtual bool SetNoteContents(const Glib::ustring& uri, const Glib::ustring& text_contents) override;
   virtual bool SetNoteContentsXml(const Glib::ustring& uri, const Glib::ustring& xml_contents) override;
@@ -77,10 +87,19 @@ private:
   void on_note_added(NoteBase &);
   void on_note_deleted(NoteBase &);
   void on_note_saved(NoteBase &);
+  void on_change_recorded(const ChangeJournal::Change & change);
+  void emit_notes_changed();
   MainWindow & present_note(NoteBase &);
+  std::map<Glib::ustring, Glib::VariantBase> get_note_metadata(const NoteBase &);
 
   IGnote & m_gnote;
   NoteManagerBase & m_manager;
+  ChangeJournal m_journal;
+  SearchResultCache m_search_cache;
+  // changes waiting for the next NotesChanged signal
+  ChangeBatch m_pending_changes;
+  utils::InterruptableTimeout m_notes_changed_timeout;
+  bool m_notes_changed_pending = false;
 };
 
 
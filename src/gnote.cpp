@@ -46,6 +46,7 @@
 #include "remotecontrolproxy.hpp"
 #include "utils.hpp"
 #include "tagmanager.hpp"
+#include "tracing.hpp"
 #include "dbus/remotecontrol.hpp"
 #include "sharp/streamreader.hpp"
 #include "sharp/files.hpp"
@@ -90,8 +91,12 @@ namespace gnote {
       return 0;
     }
 
+    tracing::enable_from_environment();
     int retval = run(argc, argv);
     signal_quit();
+    if(tracing::enabled()) {
+      tracing::dump();
+    }
     return retval;
   }
 
@@ -124,6 +129,9 @@ namespace gnote {
     m_is_background = cmdline.background();
     m_is_shell_search = m_cmd_line.shell_search();
     if(!m_manager) {
+      if(*cmdline.trace_file()) {
+        tracing::enable(cmdline.trace_file());
+      }
       common_init();
       register_object();
       end_main();
@@ -464,6 +472,7 @@ namespace gnote {
     , m_open_note(NULL)
     , m_open_start_here(false)
     , m_highlight_search(NULL)
+    , m_trace_file(NULL)
   {
     const GOptionEntry entries[] =
       {
@@ -476,6 +485,7 @@ namespace gnote {
         { "open-note", 0, 0, G_OPTION_ARG_STRING, &m_open_note, _("Display the existing note matching title."), _("title/url") },
         { "start-here", 0, 0, G_OPTION_ARG_NONE, &m_open_start_here, _("Display the 'Start Here' note."), NULL },
         { "highlight-search", 0, 0, G_OPTION_ARG_STRING, &m_highlight_search, _("Search and highlight text in the opened note."), _("text") },
+        { "trace-file", 0, 0, G_OPTION_ARG_FILENAME, &m_trace_file, _("Record performance trace to file in Chrome trace format."), _("path") },
         { NULL, 0, 0, (GOptionArg)0, NULL, NULL, NULL }
       };
 
@@ -614,6 +624,7 @@ namespace gnote {
             sr.read_to_end (noteXml);
 
             // Make sure noteXml is parseable
+            TRACE_OP(XML_PARSE);
             xmlDocPtr doc = xmlParseDoc((const xmlChar*)noteXml.c_str());
             if(doc) {
               xmlFreeDoc(doc);
@@ -57,6 +57,10 @@ public:
     {
       return m_note_path ? m_note_path : "";
     }
+  const gchar * trace_file() const
+    {
+      return m_trace_file ? m_trace_file : "";
+    }
   bool        needs_execute() const;
   bool        needs_immediate_execute() const;
   bool        background()
@@ -96,6 +100,7 @@ private:
   gchar*      m_open_note;
   bool        m_open_start_here;
   gchar*      m_highlight_search;
+  gchar*      m_trace_file;
 
 
   // depend on m_open_note, set in on_post_parse
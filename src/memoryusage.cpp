@@ -0,0 +1,81 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glibmm/i18n.h>
+
+#include "memoryusage.hpp"
+
+
+namespace gnote {
+namespace memory {
+
+std::atomic<std::int64_t> s_usage[static_cast<int>(Category::COUNT)] = {};
+
+
+std::int64_t usage(Category category)
+{
+  return s_usage[static_cast<int>(category)].load(std::memory_order_relaxed);
+}
+
+
+const char *category_name(Category category)
+{
+  switch(category) {
+  case Category::NOTE_XML:
+    return "note-xml";
+  case Category::NOTE_BUFFERS:
+    return "note-buffers";
+  case Category::UNDO:
+    return "undo";
+  case Category::TITLE_TRIE:
+    return "title-trie";
+  case Category::TAGS:
+    return "tags";
+  case Category::CACHES:
+    return "caches";
+  default:
+    return "";
+  }
+}
+
+
+const char *category_label(Category category)
+{
+  switch(category) {
+  case Category::NOTE_XML:
+    return _("Note contents");
+  case Category::NOTE_BUFFERS:
+    return _("Open note buffers");
+  case Category::UNDO:
+    return _("Undo history");
+  case Category::TITLE_TRIE:
+    return _("Note title index");
+  case Category::TAGS:
+    return _("Tags");
+  case Category::CACHES:
+    return _("Caches");
+  default:
+    return "";
+  }
+}
+
+}
+}
+
@@ -0,0 +1,117 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MEMORYUSAGE_HPP_
+#define _MEMORYUSAGE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+/// Approximate memory used by large data structures, grouped by subsystem.
+/// Owners keep a Tracker, set it to their current size estimate whenever it changes,
+/// and totals are kept up to date incrementally, so reading them is free.
+/// Estimates count payload plus typical allocator and container overhead, not exact heap usage.
+namespace gnote {
+namespace memory {
+
+enum class Category
+{
+  NOTE_XML,
+  NOTE_BUFFERS,
+  UNDO,
+  TITLE_TRIE,
+  TAGS,
+  CACHES,
+  COUNT
+};
+
+extern std::atomic<std::int64_t> s_usage[static_cast<int>(Category::COUNT)];
+
+inline void adjust(Category category, std::int64_t delta)
+{
+  s_usage[static_cast<int>(category)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+/// Current estimate in bytes.
+std::int64_t usage(Category category);
+/// Stable identifier, used by D-Bus interface.
+const char *category_name(Category category);
+/// Translated name to show to user.
+const char *category_label(Category category);
+
+/// Rough size of a std::map or std::set node: tree links and color next to the value.
+template <typename T>
+constexpr std::size_t tree_node_bytes()
+{
+  return sizeof(T) + 4 * sizeof(void*);
+}
+
+/// GtkTextBuffer keeps UTF-8 text in a B-tree of lines and segments, with noticeable
+/// per line and per tag toggle overhead. Count a few bytes per character.
+constexpr std::size_t text_buffer_bytes(int char_count)
+{
+  return char_count > 0 ? static_cast<std::size_t>(char_count) * 4 : 0;
+}
+
+
+class Tracker
+{
+public:
+  explicit Tracker(Category category)
+    : m_category(category)
+    , m_bytes(0)
+    {}
+  Tracker(const Tracker & other)
+    : m_category(other.m_category)
+    , m_bytes(0)
+    {
+      set(other.m_bytes);
+    }
+  ~Tracker()
+    {
+      set(0);
+    }
+  Tracker & operator=(const Tracker & other)
+    {
+      set(other.m_bytes);
+      return *this;
+    }
+
+  void set(std::size_t bytes)
+    {
+      if(bytes != m_bytes) {
+        adjust(m_category, static_cast<std::int64_t>(bytes) - static_cast<std::int64_t>(m_bytes));
+        m_bytes = bytes;
+      }
+    }
+  std::size_t bytes() const
+    {
+      return m_bytes;
+    }
+private:
+  const Category m_category;
+  std::size_t m_bytes;
+};
+
+}
+}
+
+#endif
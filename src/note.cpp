@@ -36,10 +36,10 @@
 #include "notewindow.hpp"
 #include "utils.hpp"
 #include "debug.hpp"
+#include "tracing.hpp"
 #include "notebooks/notebookmanager.hpp"
 #include "sharp/exception.hpp"
 #include "sharp/fileinfo.hpp"
-#include "sharp/string.hpp"
 
 
 namespace gnote {
@@ -76,11 +76,13 @@ namespace gnote {
       }
       dialog->signal_response().connect([&manager=notes.front().get().manager(), dialog, notes=std::move(note_uris)](int result) {
         if (result == 666) {
+          std::vector<NoteBase::Ref> to_delete;
           for(const auto & uri : notes) {
             if(auto note = manager.find_by_uri(uri)) {
-              manager.delete_note(note.value());
+              to_delete.push_back(note.value());
             }
           }
+          manager.delete_notes(to_delete);
         }
         dialog->hide();
       });
@@ -137,6 +139,7 @@ namespace gnote {
 
   NoteData::NoteData(Glib::ustring && _uri)
     : m_uri(std::move(_uri))
+    , m_text_memory(memory::Category::NOTE_XML)
     , m_cursor_pos(s_noPosition)
     , m_selection_bound_pos(s_noPosition)
     , m_width(0)
@@ -181,13 +184,13 @@ namespace gnote {
 
   void NoteDataBufferSynchronizer::set_text(Glib::ustring && t)
   {
-    data().text() = std::move(t);
+    data().set_text(std::move(t));
     synchronize_buffer();
   }
 
   void NoteDataBufferSynchronizer::invalidate_text()
   {
-    data().text() = "";
+    data().set_text("");
   }
 
   bool NoteDataBufferSynchronizer::is_text_invalid() const
@@ -198,7 +201,7 @@ namespace gnote {
   void NoteDataBufferSynchronizer::synchronize_text() const
   {
     if(is_text_invalid() && m_buffer) {
-      const_cast<NoteData&>(data()).text() = NoteBufferArchiver::serialize(m_buffer);
+      const_cast<NoteData&>(data()).set_text(NoteBufferArchiver::serialize(m_buffer));
     }
   }
 
@@ -340,6 +343,7 @@ namespace gnote {
       return;
     m_save_needed = false;
 
+    TRACE_SPAN("note_save");
     DBG_OUT("Saving '%s'...", m_data.data().title().c_str());
 
     try {
@@ -668,6 +672,7 @@ namespace gnote {
   {
     if(!m_buffer) {
       DBG_OUT("Creating buffer for %s", m_data.data().title().c_str());
+      TRACE_OP(BUFFER_CREATE);
       m_buffer = NoteBuffer::create(get_tag_table(), *this, m_gnote.preferences());
       m_data.set_buffer(Glib::RefPtr<NoteBuffer>(m_buffer));
 
@@ -735,34 +740,15 @@ namespace gnote {
 
   bool Note::is_pinned() const
   {
-    auto pinned_uris = m_gnote.preferences().menu_pinned_notes();
-    return pinned_uris.find(uri()) != Glib::ustring::npos;
+    return m_gnote.preferences().is_note_pinned(uri());
   }
 
 
   void Note::set_pinned(bool pinned) const
   {
-    Glib::ustring new_pinned;
-    auto old_pinned = m_gnote.preferences().menu_pinned_notes();
-    bool is_currently_pinned = old_pinned.find(uri()) != Glib::ustring::npos;
-
-    if (pinned == is_currently_pinned)
-      return;
-
-    if (pinned) {
-      new_pinned = uri() + " " + old_pinned;
-    } 
-    else {
-      std::vector<Glib::ustring> pinned_split;
-      sharp::string_split(pinned_split, old_pinned, " \t\n");
-      for(auto pin : pinned_split) {
-        if (!pin.empty() && (pin != uri())) {
-          new_pinned += pin + " ";
-        }
-      }
+    if(m_gnote.preferences().set_note_pinned(uri(), pinned)) {
+      m_gnote.notebook_manager().signal_note_pin_status_changed(*this, pinned);
     }
-    m_gnote.preferences().menu_pinned_notes(new_pinned);
-    m_gnote.notebook_manager().signal_note_pin_status_changed(*this, pinned);
   }
 
   void Note::enabled(bool is_enabled)
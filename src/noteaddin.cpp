@@ -46,6 +46,10 @@ namespace gnote {
        * opening already opened notes. */
       window->signal_foregrounded.connect(sigc::mem_fun(*this, &NoteAddin::on_note_foregrounded));
       window->signal_backgrounded.connect(sigc::mem_fun(*this, &NoteAddin::on_note_backgrounded));
+      // addin loaded on demand, while the note is already shown
+      if(window->host() && window->host()->is_foreground(*window)) {
+        on_note_foregrounded();
+      }
     }
   }
 
@@ -72,7 +76,7 @@ namespace gnote {
   void NoteAddin::on_note_foregrounded()
   {
     auto host = get_window()->host();
-    if(!host) {
+    if(!host || !m_action_callbacks_cids.empty()) {
       return;
     }
 
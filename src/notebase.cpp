@@ -29,6 +29,7 @@
 #include "itagmanager.hpp"
 #include "notebase.hpp"
 #include "notemanagerbase.hpp"
+#include "tracing.hpp"
 #include "base/hash.hpp"
 #include "sharp/exception.hpp"
 #include "sharp/files.hpp"
@@ -52,7 +53,7 @@ const Glib::ustring & NoteDataBufferSynchronizerBase::text() const
 
 void NoteDataBufferSynchronizerBase::set_text(Glib::ustring && t)
 {
-  data().text() = std::move(t);
+  data().set_text(std::move(t));
 }
 
 
@@ -86,6 +87,13 @@ std::vector<Glib::ustring> NoteBase::parse_tags(const xmlNodePtr tagnodes)
 
 Glib::ustring NoteBase::parse_text_content(const Glib::ustring & content)
 {
+  std::string text;
+  text.reserve(content.bytes());
+  if(sharp::xml_extract_text(content.data(), content.data() + content.bytes(), text, "list-item")) {
+    return Glib::ustring(std::move(text));
+  }
+
+  TRACE_OP(XML_PARSE);
   xmlDocPtr doc = xmlParseDoc((const xmlChar*)content.c_str());
   if(!doc) {
     return "";
@@ -132,6 +140,11 @@ const Glib::ustring & NoteBase::uri() const
   return data_synchronizer().data().uri();
 }
 
+std::size_t NoteBase::uri_hash() const
+{
+  return data_synchronizer().data().uri_hash();
+}
+
 const Glib::ustring NoteBase::id() const
 {
   return sharp::string_replace_first(data_synchronizer().data().uri(), "note://gnote/","");
@@ -328,6 +341,7 @@ void NoteBase::load_foreign_note_xml(const Glib::ustring & foreignNoteXml, Chang
   // were to throw an XmlException in the middle of processing,
   // a note could be damaged.  Therefore, we check for parseability
   // ahead of time, and throw early.
+  TRACE_OP(XML_PARSE);
   xmlDocPtr doc = xmlParseDoc((const xmlChar *)foreignNoteXml.c_str());
 
   if(!doc) {
@@ -363,6 +377,7 @@ void NoteBase::load_foreign_note_xml(const Glib::ustring & foreignNoteXml, Chang
         data_synchronizer().data().create_date() = sharp::XmlConvert::to_date_time(xml.read_string());
       }
       else if(name == "tags") {
+        TRACE_OP(XML_PARSE);
         xmlDocPtr doc2 = xmlParseDoc((const xmlChar*)xml.read_outer_xml().c_str());
         if(doc2) {
           std::vector<Glib::ustring> tag_strings = parse_tags(doc2->children);
@@ -446,6 +461,7 @@ const char *NoteArchiver::CURRENT_VERSION = "0.3";
 
 void NoteArchiver::read_file(const Glib::ustring & file, NoteData & data)
 {
+  TRACE_SPAN("note_read_file");
   Glib::ustring version;
   sharp::XmlReader xml(file);
   _read(xml, data, version);
@@ -472,6 +488,7 @@ void NoteArchiver::read(sharp::XmlReader & xml, NoteData & data)
 
 void NoteArchiver::_read(sharp::XmlReader & xml, NoteData & data, Glib::ustring & version)
 {
+  TRACE_SPAN("note_deserialize");
   Glib::ustring name;
 
   while(xml.read ()) {
@@ -488,7 +505,7 @@ void NoteArchiver::_read(sharp::XmlReader & xml, NoteData & data, Glib::ustring
       else if(name == "text") {
         // <text> is just a wrapper around <note-content>
         // NOTE: Use .text here to avoid triggering a save.
-        data.text() = xml.read_inner_xml();
+        data.set_text(xml.read_inner_xml());
       }
       else if(name == "last-change-date") {
         data.set_change_date(sharp::XmlConvert::to_date_time (xml.read_string()));
@@ -512,6 +529,7 @@ void NoteArchiver::_read(sharp::XmlReader & xml, NoteData & data, Glib::ustring
         data.height() = STRING_TO_INT(xml.read_string());
       }
       else if(name == "tags") {
+        TRACE_OP(XML_PARSE);
         xmlDocPtr doc2 = xmlParseDoc((const xmlChar*)xml.read_outer_xml().c_str());
 
         if(doc2) {
@@ -548,6 +566,8 @@ Glib::ustring NoteArchiver::write_string(const NoteData & note)
 
 void NoteArchiver::write_file(const Glib::ustring & _write_file, const NoteData & data)
 {
+  TRACE_SPAN("note_write_file");
+  TRACE_OP(FILE_WRITE);
   try {
     Glib::ustring tmp_file = _write_file + ".tmp";
     // TODO Xml doc settings
@@ -582,6 +602,7 @@ void NoteArchiver::write_file(const Glib::ustring & _write_file, const NoteData
 
 void NoteArchiver::write(sharp::XmlWriter & xml, const NoteData & data)
 {
+  TRACE_SPAN("note_serialize");
   xml.write_start_document();
   xml.write_start_element("", "note", "http://beatniksoftware.com/tomboy");
   xml.write_attribute_string("", "version", "", CURRENT_VERSION);
@@ -30,7 +30,9 @@
 #include <glibmm/ustring.h>
 #include <sigc++/signal.h>
 
+#include "memoryusage.hpp"
 #include "tag.hpp"
+#include "base/hash.hpp"
 #include "sharp/datetime.hpp"
 #include "sharp/xmlreader.hpp"
 #include "sharp/xmlwriter.hpp"
@@ -52,7 +54,11 @@ public:
 
   const Glib::ustring & uri() const
     {
-      return m_uri;
+      return m_uri.str();
+    }
+  std::size_t uri_hash() const
+    {
+      return m_uri.hash();
     }
   const Glib::ustring & title() const
     {
@@ -66,9 +72,10 @@ public:
     { 
       return m_text;
     }
-  Glib::ustring & text()
-    { 
-      return m_text;
+  void set_text(Glib::ustring && text)
+    {
+      m_text = std::move(text);
+      m_text_memory.set(m_text.raw().capacity());
     }
   const Glib::DateTime & create_date() const
     {
@@ -140,9 +147,10 @@ public:
   bool has_extent();
 
 private:
-  const Glib::ustring m_uri;
+  const HashedString m_uri;
   Glib::ustring     m_title;
   Glib::ustring     m_text;
+  memory::Tracker   m_text_memory;
   Glib::DateTime    m_create_date;
   Glib::DateTime    m_change_date;
   Glib::DateTime    m_metadata_change_date;
@@ -211,6 +219,7 @@ public:
 
   int get_hash_code() const;
   const Glib::ustring & uri() const;
+  std::size_t uri_hash() const;
   const Glib::ustring id() const;
   const Glib::ustring & get_title() const;
   void set_title(Glib::ustring && new_title);
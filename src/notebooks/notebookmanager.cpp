@@ -147,6 +147,7 @@ namespace gnote {
       if(tag) {
         notes = tag->get_notes();
       }
+      NoteManagerBase::BulkMutation bulk(note_manager());
       for(NoteBase *note : notes) {
         note->remove_tag(tag);
         signal_note_removed_from_notebook(*static_cast<Note*>(note), notebook);
@@ -260,6 +261,7 @@ namespace gnote {
         
       if(!notes_to_add.empty()) {
         // Move all the specified notesToAdd into the new notebook
+        NoteManagerBase::BulkMutation bulk(notebook.note_manager());
         for(const auto & note : notes_to_add) {
           notebook.note_manager().find_by_uri(note, [&g, &notebook](NoteBase & note) {
             g.notebook_manager().move_note_to_notebook(static_cast<Note&>(note), notebook);
@@ -87,6 +87,7 @@ namespace gnote {
           }
           else if(G_VALUE_HOLDS(value.gobj(), Glib::Value<std::vector<Glib::ustring>>::value_type())) {
             auto uris = static_cast<const Glib::Value<std::vector<Glib::ustring>>&>(value).get();
+            NoteManagerBase::BulkMutation bulk(dest_notebook->note_manager());
             bool ret = false;
             for(const auto & uri : uris) {
               ret = drop(uri) || ret;
@@ -373,10 +374,13 @@ namespace gnote {
       auto & new_notebook = notebook_manager.get_or_create_notebook(new_name);
       DBG_OUT("Renaming notebook '{%s}' to '{%s}'", old_notebook.get_name().c_str(), new_name.c_str());
       auto notes = old_notebook.get_tag()->get_notes();
-      for(NoteBase *note : notes) {
-        notebook_manager.move_note_to_notebook(static_cast<Note&>(*note), new_notebook);
+      {
+        NoteManagerBase::BulkMutation bulk(m_note_manager);
+        for(NoteBase *note : notes) {
+          notebook_manager.move_note_to_notebook(static_cast<Note&>(*note), new_notebook);
+        }
+        notebook_manager.delete_notebook(const_cast<Notebook&>(old_notebook));
       }
-      notebook_manager.delete_notebook(const_cast<Notebook&>(old_notebook));
       select_notebook(new_notebook);
     }
 
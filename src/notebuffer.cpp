@@ -64,10 +64,12 @@ namespace gnote {
     , m_undomanager(NULL)
     , m_note(note_)
     , m_preferences(preferences)
+    , m_memory(memory::Category::NOTE_BUFFERS)
   {
     set_enable_undo(false);  // for now use our own legacy undo
     m_undomanager = new UndoManager(this);
     signal_insert().connect(sigc::mem_fun(*this, &NoteBuffer::text_insert_event));
+    signal_changed().connect([this] { m_memory.set(memory::text_buffer_bytes(get_char_count())); });
     signal_mark_set().connect(sigc::mem_fun(*this, &NoteBuffer::mark_set_event));
 
     signal_apply_tag().connect(sigc::mem_fun(*this, &NoteBuffer::on_tag_applied), false);
@@ -31,6 +31,7 @@
 #include <gtkmm/texttag.h>
 #include <gtkmm/widget.h>
 
+#include "memoryusage.hpp"
 #include "notetag.hpp"
 
 namespace sharp {
@@ -155,6 +156,7 @@ private:
   // The note that owns this buffer
   Note &                       m_note;
   Preferences &                m_preferences;
+  memory::Tracker              m_memory;
 };
 
 class NoteBufferArchiver
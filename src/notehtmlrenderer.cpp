@@ -0,0 +1,158 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <libxml/xpathInternals.h>
+#include <libxslt/extensions.h>
+
+#include <pangomm/fontdescription.h>
+
+#include "config.h"
+#include "debug.hpp"
+#include "tracing.hpp"
+#include "utils.hpp"
+#include "sharp/exception.hpp"
+#include "sharp/files.hpp"
+
+#include "notehtmlrenderer.hpp"
+
+#define STYLESHEET_NAME "exporttohtml.xsl"
+
+
+namespace gnote {
+namespace html {
+
+namespace {
+
+void to_lower(xmlXPathParserContextPtr ctxt, int)
+{
+  const xmlChar *input = xmlXPathPopString(ctxt);
+  gchar * lower = g_utf8_strdown((const gchar*)input, -1);
+  xmlXPathReturnString(ctxt, xmlStrdup((const xmlChar*)lower));
+  g_free(lower);
+}
+
+
+void encode_uri(xmlXPathParserContextPtr ctxt, int)
+{
+  xmlChar *input = xmlXPathPopString(ctxt);
+  gchar *escaped = g_uri_escape_string((const gchar*)input, NULL, TRUE);
+  xmlFree(input);
+  xmlXPathReturnString(ctxt, xmlStrdup((const xmlChar*)escaped));
+  g_free(escaped);
+}
+
+
+void register_function(const char *name, xmlXPathFunction function)
+{
+  int result = xsltRegisterExtModuleFunction((const xmlChar *)name,
+                                             (const xmlChar *)"http://beatniksoftware.com/tomboy",
+                                             function);
+  DBG_OUT("xsltRegisterExtModule %s %d", name, result);
+  if(result == -1) {
+    DBG_OUT("xsltRegisterExtModule failed");
+  }
+}
+
+Glib::ustring & stylesheet_file()
+{
+  static Glib::ustring s_file = DATADIR "/gnote/" STYLESHEET_NAME;
+  return s_file;
+}
+
+sharp::XslTransform *load_note_xsl()
+{
+  // extension functions go to global libxslt table, which must not change while transforms run
+  register_function("ToLower", &to_lower);
+  register_function("EncodeUri", &encode_uri);
+
+  sharp::XslTransform *xsl = new sharp::XslTransform;
+  const Glib::ustring & stylesheet_file = html::stylesheet_file();
+
+  if (sharp::file_exists (stylesheet_file)) {
+    DBG_OUT("ExportToHTML: Using user-custom %s file.", STYLESHEET_NAME);
+    xsl->load(stylesheet_file);
+  }
+  return xsl;
+}
+
+}
+
+
+sharp::XslTransform & note_xsl()
+{
+  static sharp::XslTransform *s_xsl = load_note_xsl();
+  return *s_xsl;
+}
+
+
+void note_xsl_file(const Glib::ustring & stylesheet_file)
+{
+  html::stylesheet_file() = stylesheet_file;
+}
+
+
+Glib::ustring note_font_css(Preferences & preferences)
+{
+  if(!preferences.enable_custom_font()) {
+    return "";
+  }
+  Pango::FontDescription font_desc(preferences.custom_font_face());
+  return Glib::ustring::compose("font-family:'%1';", font_desc.get_family());
+}
+
+
+sharp::XsltArgumentList note_xsl_args(const Glib::ustring & title, const Glib::ustring & font,
+                                      bool export_linked, bool export_linked_all, const Glib::ustring & link_base)
+{
+  sharp::XsltArgumentList args;
+  args.add_param("export-linked", "", export_linked);
+  args.add_param("export-linked-all", "", export_linked_all);
+  args.add_param("root-note", "", utils::XmlEncoder::encode(title));
+  if(!font.empty()) {
+    args.add_param("font", "", font);
+  }
+  if(!link_base.empty()) {
+    args.add_param("link-base", "", link_base);
+  }
+  return args;
+}
+
+
+std::string render_note_html(const std::string & note_xml, const sharp::XsltArgumentList & args)
+{
+  TRACE_SPAN("render_note_html");
+  TRACE_OP(XML_PARSE);
+  xmlDocPtr doc = xmlParseMemory(note_xml.c_str(), note_xml.size());
+  if(!doc) {
+    return "";
+  }
+  std::string html;
+  try {
+    html = note_xsl().transform_to_string(doc, args);
+  }
+  catch(const sharp::Exception & e) {
+    ERR_OUT("Failed to render note: %s", e.what());
+  }
+  xmlFreeDoc(doc);
+  return html;
+}
+
+}
+}
@@ -0,0 +1,57 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NOTEHTMLRENDERER_HPP_
+#define _NOTEHTMLRENDERER_HPP_
+
+#include <string>
+
+#include "preferences.hpp"
+#include "sharp/xsltargumentlist.hpp"
+#include "sharp/xsltransform.hpp"
+
+
+namespace gnote {
+namespace html {
+
+/// exporttohtml.xsl, loaded and its extension functions registered once, on first use.
+/// Call it before starting threads that render, after that the transformation can be applied from any thread.
+sharp::XslTransform & note_xsl();
+
+/// Load the stylesheet from another file instead of the installed one, for running uninstalled.
+/// Only has effect before the first call to note_xsl().
+void note_xsl_file(const Glib::ustring & stylesheet_file);
+
+/// CSS font declaration for the custom font, empty if it is not enabled.
+Glib::ustring note_font_css(Preferences & preferences);
+
+/// Stylesheet parameters for exporting a note with the given title.
+/// If link_base is not empty, internal links point to it followed by the URI escaped linked title,
+/// otherwise they point to anchors in the same page.
+sharp::XsltArgumentList note_xsl_args(const Glib::ustring & title, const Glib::ustring & font,
+                                      bool export_linked, bool export_linked_all,
+                                      const Glib::ustring & link_base = "");
+
+/// Renders complete note XML to HTML, without linked notes. Can be called from any thread.
+std::string render_note_html(const std::string & note_xml, const sharp::XsltArgumentList & args);
+
+}
+}
+
+#endif
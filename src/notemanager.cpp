@@ -32,6 +32,7 @@
 #include "addinmanager.hpp"
 #include "ignote.hpp"
 #include "itagmanager.hpp"
+#include "tracing.hpp"
 #include "sharp/directory.hpp"
 #include "sharp/dynamicmodule.hpp"
 
@@ -160,8 +161,12 @@ namespace gnote {
 
   void NoteManager::load_notes()
   {
+    TRACE_SPAN("load_notes");
     std::vector<Glib::ustring> files = sharp::directory_get_files_with_ext(notes_dir(), ".note");
+    TRACE_COUNTER("note_files", files.size());
 
+    m_tag_manager.begin_bulk_load();
+    begin_bulk_mutation();
     for(auto & file_path : files) {
       try {
         Note::Ptr note = Note::load(std::move(file_path), *this, gnote());
@@ -173,6 +178,8 @@ namespace gnote {
                 file_path.c_str(), e.what());
       }
     }
+    end_bulk_mutation();
+    m_tag_manager.end_bulk_load();
     post_load();
     // Make sure that a Start Note Uri is set in the preferences, and
     // make sure that the Uri is valid to prevent bug #508982. This
@@ -24,7 +24,9 @@
 
 #include "debug.hpp"
 #include "ignote.hpp"
+#include "memoryusage.hpp"
 #include "notemanagerbase.hpp"
+#include "tracing.hpp"
 #include "utils.hpp"
 #include "trie.hpp"
 #include "notebooks/notebookmanager.hpp"
@@ -37,6 +39,19 @@
 
 namespace gnote {
 
+namespace {
+
+gint64 change_date_key(const NoteBase & note)
+{
+  const Glib::DateTime & date = note.change_date();
+  if(!date) {
+    return 0;
+  }
+  return date.to_unix() * G_USEC_PER_SEC + date.get_microsecond();
+}
+
+}
+
 class TrieController
 {
 public:
@@ -44,6 +59,8 @@ public:
 
   void add_note(const NoteBase::Ptr & note);
   void update();
+  void freeze();
+  void thaw();
   TrieTree<Glib::ustring> & title_trie() const
     {
       return *m_title_trie;
@@ -55,6 +72,9 @@ private:
 
   NoteManagerBase & m_manager;
   std::unique_ptr<TrieTree<Glib::ustring>> m_title_trie;
+  unsigned m_frozen;
+  bool m_update_pending;
+  memory::Tracker m_memory;
 };
 
 
@@ -85,6 +105,9 @@ Glib::ustring NoteManagerBase::sanitize_xml_content(const Glib::ustring & xml_co
 NoteManagerBase::NoteManagerBase(IGnote & g)
   : m_gnote(g)
   , m_trie_controller(NULL)
+  , m_notes_snapshot(std::make_shared<std::vector<NoteBase::Ptr>>())
+  , m_snapshot_memory(memory::Category::CACHES)
+  , m_bulk_mutations(0)
 {
 }
 
@@ -172,6 +195,7 @@ std::vector<NoteBase::Ref> NoteManagerBase::get_notes_linking_to(const Glib::ust
 {
   Glib::ustring tag = "<link:internal>" + utils::XmlEncoder::encode(title) + "</link:internal>";
   std::vector<NoteBase::Ref> result;
+  TRACE_OP(REGISTRY_SCAN);
   for(const NoteBase::Ptr & note : m_notes) {
     if(note->get_title() != title) {
       if(note->get_complete_note_xml().find(tag) != Glib::ustring::npos) {
@@ -187,10 +211,23 @@ void NoteManagerBase::add_note(NoteBase::Ptr note)
   if(note) {
     note->signal_renamed.connect(sigc::mem_fun(*this, &NoteManagerBase::on_note_rename));
     note->signal_saved.connect(sigc::mem_fun(*this, &NoteManagerBase::on_note_save));
+    update_change_date_index(*note);
+    m_notes_by_uri[note->uri()] = note;
     m_notes.insert(std::move(note));
+    publish_notes_snapshot();
   }
 }
 
+void NoteManagerBase::publish_notes_snapshot()
+{
+  if(m_bulk_mutations) {
+    return;
+  }
+  auto snapshot = std::make_shared<std::vector<NoteBase::Ptr>>(m_notes.begin(), m_notes.end());
+  m_snapshot_memory.set(snapshot->capacity() * sizeof(NoteBase::Ptr));
+  std::atomic_store(&m_notes_snapshot, NotesSnapshot(std::move(snapshot)));
+}
+
 void NoteManagerBase::on_note_rename(const NoteBase & note, const Glib::ustring & old_title)
 {
   signal_note_renamed(note, old_title);
@@ -198,11 +235,38 @@ void NoteManagerBase::on_note_rename(const NoteBase & note, const Glib::ustring
 
 void NoteManagerBase::on_note_save(NoteBase & note)
 {
+  update_change_date_index(note);
   signal_note_saved(note);
 }
 
+void NoteManagerBase::update_change_date_index(NoteBase & note)
+{
+  gint64 key = change_date_key(note);
+  auto pos = m_change_date_positions.find(&note);
+  if(pos != m_change_date_positions.end()) {
+    if(pos->second->first == key) {
+      return;
+    }
+    m_change_date_index.erase(pos->second);
+    pos->second = m_change_date_index.emplace(key, &note);
+  }
+  else {
+    m_change_date_positions.emplace(&note, m_change_date_index.emplace(key, &note));
+  }
+}
+
+void NoteManagerBase::remove_from_change_date_index(const NoteBase & note)
+{
+  auto pos = m_change_date_positions.find(&note);
+  if(pos != m_change_date_positions.end()) {
+    m_change_date_index.erase(pos->second);
+    m_change_date_positions.erase(pos);
+  }
+}
+
 NoteBase::ORef NoteManagerBase::find(const Glib::ustring & linked_title) const
 {
+  TRACE_OP(REGISTRY_SCAN);
   for(const NoteBase::Ptr & note : m_notes) {
     if(note->get_title().lowercase() == linked_title.lowercase()) {
       return std::ref(*note);
@@ -213,10 +277,9 @@ NoteBase::ORef NoteManagerBase::find(const Glib::ustring & linked_title) const
 
 NoteBase::ORef NoteManagerBase::find_by_uri(const Glib::ustring & uri) const
 {
-  for(const NoteBase::Ptr & note : m_notes) {
-    if (note->uri() == uri) {
-      return std::ref(*note);
-    }
+  auto iter = m_notes_by_uri.find(uri);
+  if(iter != m_notes_by_uri.end()) {
+    return std::ref(*iter->second);
   }
   return NoteBase::ORef();
 }
@@ -323,6 +386,9 @@ NoteBase & NoteManagerBase::create_new_note(Glib::ustring && title, Glib::ustrin
   new_note->signal_saved.connect(sigc::mem_fun(*this, &NoteManagerBase::on_note_save));
 
   m_notes.insert(new_note);
+  m_notes_by_uri[new_note->uri()] = new_note;
+  update_change_date_index(*new_note);
+  publish_notes_snapshot();
 
   signal_note_added(*new_note);
 
@@ -421,14 +487,15 @@ void NoteManagerBase::delete_note(NoteBase & note)
   DBG_OUT("Deleting note '%s'.", note.get_title().c_str());
   NoteBase::Ptr cached_ref;  // prevent note from being destroyed
 
-  for(auto iter = m_notes.begin(); iter != m_notes.end(); ++iter) {
-    if(iter->get() == &note) {
-      cached_ref = *iter;
-      m_notes.erase(iter);
-      break;
-    }
+  auto iter = m_notes_by_uri.find(note.uri());
+  if(iter != m_notes_by_uri.end() && iter->second.get() == &note) {
+    cached_ref = std::move(iter->second);
+    m_notes_by_uri.erase(iter);
+    m_notes.erase(cached_ref);
+    publish_notes_snapshot();
   }
   DBG_ASSERT(cached_ref != nullptr, "Deleting note that is not present");
+  remove_from_change_date_index(note);
   note.delete_note();
   signal_note_deleted(note);
 
@@ -452,6 +519,37 @@ void NoteManagerBase::delete_note(NoteBase & note)
   }
 }
 
+void NoteManagerBase::delete_notes(const std::vector<NoteBase::Ref> & notes)
+{
+  BulkMutation bulk(*this);
+  for(NoteBase & note : notes) {
+    delete_note(note);
+  }
+}
+
+void NoteManagerBase::begin_bulk_mutation()
+{
+  ++m_bulk_mutations;
+  if(m_trie_controller) {
+    m_trie_controller->freeze();
+  }
+}
+
+void NoteManagerBase::end_bulk_mutation()
+{
+  if(m_bulk_mutations == 0) {
+    ERR_OUT("Bulk mutation ended without beginning");
+    return;
+  }
+  if(m_trie_controller) {
+    m_trie_controller->thaw();
+  }
+  if(--m_bulk_mutations == 0) {
+    publish_notes_snapshot();
+    signal_bulk_mutation_ended();
+  }
+}
+
 NoteBase::ORef NoteManagerBase::import_note(const Glib::ustring & file_path)
 {
   Glib::ustring dest_file = Glib::build_filename(notes_dir(), 
@@ -498,14 +596,16 @@ NoteBase & NoteManagerBase::create_with_guid(Glib::ustring && title, Glib::ustri
 
 std::size_t NoteManagerBase::NoteHash::operator()(const NoteBase::Ptr & note) const noexcept
 {
-  Hash<Glib::ustring> hash;
-  return hash(note->uri());
+  return note->uri_hash();
 }
 
 
 
 TrieController::TrieController(NoteManagerBase & manager)
   : m_manager(manager)
+  , m_frozen(0)
+  , m_update_pending(false)
+  , m_memory(memory::Category::TITLE_TRIE)
 {
   m_manager.signal_note_deleted.connect(sigc::mem_fun(*this, &TrieController::on_note_deleted));
   m_manager.signal_note_added.connect(sigc::mem_fun(*this, &TrieController::on_note_added));
@@ -521,28 +621,59 @@ void TrieController::on_note_added(NoteBase & note)
 
 void TrieController::on_note_deleted(NoteBase &)
 {
+  if(m_frozen) {
+    m_update_pending = true;
+    return;
+  }
   update();
 }
 
 void TrieController::on_note_renamed(const NoteBase &, const Glib::ustring &)
 {
+  if(m_frozen) {
+    m_update_pending = true;
+    return;
+  }
   update();
 }
 
+void TrieController::freeze()
+{
+  ++m_frozen;
+}
+
+void TrieController::thaw()
+{
+  if(m_frozen > 0 && --m_frozen == 0 && m_update_pending) {
+    m_update_pending = false;
+    update();
+  }
+}
+
 void TrieController::add_note(const NoteBase::Ptr & note)
 {
+  if(m_frozen) {
+    m_update_pending = true;
+    return;
+  }
   m_title_trie->add_keyword(note->get_title(), note->uri());
+  // recomputing failure graph is as costly as full rebuild
+  TRACE_OP(TRIE_REBUILD);
   m_title_trie->compute_failure_graph();
+  m_memory.set(m_title_trie->memory_size());
 }
 
 void TrieController::update()
 {
+  TRACE_SPAN("trie_rebuild");
+  TRACE_OP(TRIE_REBUILD);
   m_title_trie = std::make_unique<TrieTree<Glib::ustring>>(false /* !case_sensitive */);
 
   m_manager.for_each([this](NoteBase & note) {
     m_title_trie->add_keyword(note.get_title(), note.uri());
   });
   m_title_trie->compute_failure_graph();
+  m_memory.set(m_title_trie->memory_size());
 }
 
 
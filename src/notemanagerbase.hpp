@@ -22,9 +22,13 @@
 #ifndef _NOTEMANAGERBASE_HPP_
 #define _NOTEMANAGERBASE_HPP_
 
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "itagmanager.hpp"
+#include "base/hash.hpp"
 #include "notebase.hpp"
 #include "triehit.hpp"
 
@@ -44,6 +48,27 @@ class NoteManagerBase
 {
 public:
   typedef sigc::signal<void(NoteBase&)> ChangedHandler;
+  typedef std::shared_ptr<const std::vector<NoteBase::Ptr>> NotesSnapshot;
+
+  /// Changes many notes at once. Updates of derived data (title trie, notes snapshot,
+  /// listeners of signal_bulk_mutation_ended) are done once, when the outermost scope ends.
+  class BulkMutation
+  {
+  public:
+    explicit BulkMutation(NoteManagerBase & manager)
+      : m_manager(manager)
+      {
+        m_manager.begin_bulk_mutation();
+      }
+    ~BulkMutation()
+      {
+        m_manager.end_bulk_mutation();
+      }
+    BulkMutation(const BulkMutation&) = delete;
+    BulkMutation & operator=(const BulkMutation&) = delete;
+  private:
+    NoteManagerBase & m_manager;
+  };
 
   static Glib::ustring sanitize_xml_content(const Glib::ustring & xml_content);
   static Glib::ustring get_note_template_content(const Glib::ustring & title);
@@ -93,6 +118,15 @@ public:
   NoteBase::ORef find_template_note() const;
   Glib::ustring get_unique_name(const Glib::ustring & basename) const;
   void delete_note(NoteBase & note);
+  // Delete many notes at once, derived data like title trie is updated only once
+  void delete_notes(const std::vector<NoteBase::Ref> & notes);
+  // Prefer BulkMutation, calls must be paired
+  void begin_bulk_mutation();
+  void end_bulk_mutation();
+  bool in_bulk_mutation() const
+    {
+      return m_bulk_mutations > 0;
+    }
   // Import a note read from file_path
   // Will ensure the sanity including the unique title.
   NoteBase::ORef import_note(const Glib::ustring & file_path);
@@ -107,6 +141,14 @@ public:
       return m_notes.size();
     }
 
+  /// Immutable list of notes, republished after every change.
+  /// Can be taken and iterated from any thread, but the notes themselves are not thread safe.
+  /// A snapshot may hold the last reference to a deleted note, so it must be released on the main thread.
+  NotesSnapshot notes_snapshot() const
+    {
+      return std::atomic_load(&m_notes_snapshot);
+    }
+
   template <typename F>
   void for_each(const F & func) const
     {
@@ -115,6 +157,15 @@ public:
       }
     }
 
+  // Iterate notes ordered by change date, most recently changed first
+  template <typename F>
+  void for_each_by_change_date(const F & func) const
+    {
+      for(const auto & entry : m_change_date_index) {
+        func(*entry.second);
+      }
+    }
+
   template <typename RetT, typename FuncT>
   RetT search(const FuncT & func, const RetT & default_ret) const
     {
@@ -139,6 +190,8 @@ public:
   ChangedHandler signal_note_added;
   NoteBase::RenamedHandler signal_note_renamed;
   NoteBase::SavedHandler signal_note_saved;
+  // Listeners of above signals can postpone expensive work while in_bulk_mutation()
+  sigc::signal<void()> signal_bulk_mutation_ended;
 protected:
   bool init(const Glib::ustring & directory, const Glib::ustring & backup);
   virtual void post_load();
@@ -161,6 +214,7 @@ protected:
   };
 
   std::unordered_set<NoteBase::Ptr, NoteHash> m_notes;
+  std::unordered_map<Glib::ustring, NoteBase::Ptr, Hash<Glib::ustring>> m_notes_by_uri;
   Glib::ustring m_backup_dir;
   Glib::ustring m_default_note_template_title;
 private:
@@ -168,11 +222,22 @@ private:
   void create_notes_dir() const;
   bool create_directory(const Glib::ustring & directory) const;
   TrieController *create_trie_controller();
+  void update_change_date_index(NoteBase & note);
+  void remove_from_change_date_index(const NoteBase & note);
+  void publish_notes_snapshot();
+
+  typedef std::multimap<gint64, NoteBase*, std::greater<gint64>> ChangeDateIndex;
 
   IGnote & m_gnote;
   TrieController *m_trie_controller;
   Glib::ustring m_notes_dir;
   bool m_read_only;
+  ChangeDateIndex m_change_date_index;
+  std::unordered_map<const NoteBase*, ChangeDateIndex::iterator> m_change_date_positions;
+  // only replaced on main thread, readers use atomic_load
+  NotesSnapshot m_notes_snapshot;
+  memory::Tracker m_snapshot_memory;
+  unsigned m_bulk_mutations;
 };
 
 }
@@ -22,6 +22,8 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
+
 #include <glibmm/i18n.h>
 #include <gtkmm/grid.h>
 #include <gtkmm/image.h>
@@ -179,6 +181,29 @@ namespace gnote {
       .connect(sigc::mem_fun(*this, &NoteWindow::increase_indent_clicked)));
     m_signal_cids.push_back(host->find_action("decrease-indent")->signal_activate()
       .connect(sigc::mem_fun(*this, &NoteWindow::decrease_indent_clicked)));
+
+    // on demand plugins get loaded when their action is first used
+    NoteManager & manager = static_cast<NoteManager&>(m_note.manager());
+    for(auto & action_name : manager.get_addin_manager().get_deferred_actions()) {
+      if(auto action = host->find_action(action_name)) {
+        m_signal_cids.push_back(action->signal_activate()
+          .connect(sigc::bind(sigc::mem_fun(*this, &NoteWindow::on_deferred_action_activated), action_name)));
+      }
+    }
+  }
+
+  void NoteWindow::on_deferred_action_activated(const Glib::VariantBase & parameter, const Glib::ustring & action_name)
+  {
+    NoteManager & manager = static_cast<NoteManager&>(m_note.manager());
+    if(!manager.get_addin_manager().load_module_for_action(action_name)) {
+      return;
+    }
+    // the newly loaded note addins are connected now, activate again for them
+    if(auto current_host = host()) {
+      if(auto action = current_host->find_action(action_name)) {
+        action->activate(parameter);
+      }
+    }
   }
 
   void NoteWindow::disconnect_actions()
@@ -326,6 +351,7 @@ namespace gnote {
     popover_widgets.push_back(PopoverWidget(NOTE_SECTION_FLAGS, IMPORTANT_ORDER, important));
 
     NoteManager & manager = static_cast<NoteManager&>(m_note.manager());
+    manager.get_addin_manager().load_deferred_modules();
     for(NoteAddin *addin : manager.get_addin_manager().get_note_addins(m_note)) {
       auto addin_widgets = addin->get_actions_popover_widgets();
       popover_widgets.insert(popover_widgets.end(), addin_widgets.begin(), addin_widgets.end());
@@ -742,64 +768,86 @@ namespace gnote {
   }
 
 
+  namespace {
+    // rescan edited text when user pauses typing
+    const guint FIND_RESCAN_TIMEOUT = 500;
+
+    struct MatchStartLess
+    {
+      template <typename Match>
+      bool operator()(const Match & match, int offset) const
+        {
+          return match.start < offset;
+        }
+      template <typename Match>
+      bool operator()(const Match & a, const Match & b) const
+        {
+          return a.start < b.start;
+        }
+    };
+  }
+
+
   NoteFindHandler::NoteFindHandler(Note & note)
     : m_note(note)
+    , m_max_word_length(0)
+    , m_highlight_start(0)
+    , m_highlight_end(0)
+    , m_changed_start(-1)
+    , m_changed_end(-1)
   {
+    m_note_changed_timeout.signal_timeout.connect(sigc::mem_fun(*this, &NoteFindHandler::note_changed_timeout));
   }
 
-  bool NoteFindHandler::goto_previous_result()
+
+  NoteFindHandler::~NoteFindHandler()
   {
-    if (m_current_matches.empty() || m_current_matches.size() == 0)
-      return false;
+    for(auto & cid : m_signal_cids) {
+      cid.disconnect();
+    }
+  }
 
-    Match *previous_match = nullptr;
-    for (auto & match : m_current_matches) {
-      Glib::RefPtr<NoteBuffer> buffer = match.buffer;
-      Gtk::TextIter selection_start, selection_end;
-      buffer->get_selection_bounds(selection_start, selection_end);
-      Gtk::TextIter end = buffer->get_iter_at_mark(match.start_mark);
 
-      if (end.get_offset() < selection_start.get_offset()) {
-        previous_match = &match;
-      }
-      else {
-        break;
-      }
+  bool NoteFindHandler::goto_previous_result()
+  {
+    if(m_current_matches.empty()) {
+      return false;
     }
-    if(previous_match) {
-      jump_to_match(*previous_match);
-      return true;
+
+    Gtk::TextIter selection_start, selection_end;
+    m_note.get_buffer()->get_selection_bounds(selection_start, selection_end);
+    auto iter = std::lower_bound(m_current_matches.begin(), m_current_matches.end(), selection_start.get_offset(), MatchStartLess());
+    if(iter == m_current_matches.begin()) {
+      return false;
     }
 
-    return false;
+    jump_to_match(*--iter);
+    return true;
   }
 
   bool NoteFindHandler::goto_next_result()
   {
-    if (m_current_matches.empty() || m_current_matches.size() == 0)
+    if(m_current_matches.empty()) {
       return false;
+    }
 
-    for (auto & match : m_current_matches) {
-      Glib::RefPtr<NoteBuffer> buffer = match.buffer;
-      Gtk::TextIter selection_start, selection_end;
-      buffer->get_selection_bounds(selection_start, selection_end);
-      Gtk::TextIter start = buffer->get_iter_at_mark(match.start_mark);
-
-      if (start.get_offset() >= selection_end.get_offset()) {
-        jump_to_match(match);
-        return true;
-      }
+    Gtk::TextIter selection_start, selection_end;
+    m_note.get_buffer()->get_selection_bounds(selection_start, selection_end);
+    auto iter = std::lower_bound(m_current_matches.begin(), m_current_matches.end(), selection_end.get_offset(), MatchStartLess());
+    if(iter == m_current_matches.end()) {
+      return false;
     }
 
-    return false;
+    jump_to_match(*iter);
+    return true;
   }
 
   void NoteFindHandler::jump_to_match(const Match & match)
   {
-    Glib::RefPtr<NoteBuffer> buffer(match.buffer);
+    Glib::RefPtr<NoteBuffer> buffer = m_note.get_buffer();
 
-    Gtk::TextIter start = buffer->get_iter_at_mark(match.start_mark);
-    Gtk::TextIter end = buffer->get_iter_at_mark(match.end_mark);
+    Gtk::TextIter start = buffer->get_iter_at_offset(match.start);
+    Gtk::TextIter end = buffer->get_iter_at_offset(match.end);
 
     // Move cursor to end of match, and select match text
     buffer->place_cursor(end);
@@ -820,107 +868,251 @@ namespace gnote {
     Glib::ustring text(txt);
     text = text.lowercase();
 
-    std::vector<Glib::ustring> words;
-    Search::split_watching_quotes(words, text);
-
-    find_matches_in_buffer(m_note.get_buffer(), words, m_current_matches);
+    Search::split_watching_quotes(m_words, text);
+    m_words.erase(std::remove(m_words.begin(), m_words.end(), Glib::ustring()), m_words.end());
+    for(const auto & word : m_words) {
+      m_max_word_length = std::max<int>(m_max_word_length, word.size());
+    }
 
-    if(!m_current_matches.empty()) {
-      highlight_matches(true);
-      jump_to_match(m_current_matches.front());
+    Glib::RefPtr<NoteBuffer> buffer = m_note.get_buffer();
+    if(m_words.empty() || !find_matches_in_buffer(buffer, 0, buffer->end().get_offset(), m_current_matches)) {
+      m_current_matches.clear();
+      return;
     }
+
+    // keep match offsets valid while editing, tags are only applied to what gets shown
+    m_signal_cids.push_back(buffer->signal_insert().connect(sigc::mem_fun(*this, &NoteFindHandler::on_insert_text)));
+    m_signal_cids.push_back(buffer->signal_erase().connect(sigc::mem_fun(*this, &NoteFindHandler::on_delete_range), false));
+    auto vadjustment = m_note.get_window()->editor()->get_vadjustment();
+    m_signal_cids.push_back(vadjustment->signal_value_changed().connect(sigc::mem_fun(*this, &NoteFindHandler::update_highlighting)));
+    m_signal_cids.push_back(vadjustment->signal_changed().connect(sigc::mem_fun(*this, &NoteFindHandler::update_highlighting)));
+
+    jump_to_match(m_current_matches.front());
+    update_highlighting();
   }
 
-  void NoteFindHandler::highlight_matches(bool highlight)
+
+  void NoteFindHandler::note_changed_timeout()
   {
-    if(m_current_matches.empty()) {
+    if(m_changed_start < 0) {
       return;
     }
 
-    for(auto & match : m_current_matches) {
-      Glib::RefPtr<NoteBuffer> buffer = match.buffer;
+    // matches touching changed region can start or end this far from it
+    Glib::RefPtr<NoteBuffer> buffer = m_note.get_buffer();
+    int start = std::max(0, m_changed_start - m_max_word_length);
+    int end = std::min(buffer->end().get_offset(), m_changed_end + m_max_word_length);
+    m_changed_start = m_changed_end = -1;
 
-      if (match.highlighting != highlight) {
-        Gtk::TextIter start = buffer->get_iter_at_mark(match.start_mark);
-        Gtk::TextIter end = buffer->get_iter_at_mark(match.end_mark);
+    // everything inside gets found again
+    m_current_matches.erase(std::remove_if(m_current_matches.begin(), m_current_matches.end(), [start, end](const Match & match) {
+      return match.start >= start && match.end <= end;
+    }), m_current_matches.end());
+    auto old_count = m_current_matches.size();
+    find_matches_in_buffer(buffer, start, end, m_current_matches);
+    std::inplace_merge(m_current_matches.begin(), m_current_matches.begin() + old_count, m_current_matches.end(), MatchStartLess());
+
+    int highlight_start = std::max(start, m_highlight_start);
+    int highlight_end = std::min(end, m_highlight_end);
+    if(highlight_start >= highlight_end) {
+      return;
+    }
+    buffer->remove_tag_by_name("find-match", buffer->get_iter_at_offset(highlight_start), buffer->get_iter_at_offset(highlight_end));
+    auto iter = std::lower_bound(m_current_matches.begin(), m_current_matches.end(), highlight_start - m_max_word_length, MatchStartLess());
+    for(; iter != m_current_matches.end() && iter->start < highlight_end; ++iter) {
+      if(iter->end > highlight_start) {
+        buffer->apply_tag_by_name("find-match", buffer->get_iter_at_offset(std::max(iter->start, m_highlight_start)),
+                                  buffer->get_iter_at_offset(std::min(iter->end, m_highlight_end)));
+      }
+    }
+  }
 
-        match.highlighting = highlight;
 
-        if (match.highlighting) {
-          buffer->apply_tag_by_name("find-match", start, end);
-        }
-        else {
-          buffer->remove_tag_by_name("find-match", start, end);
-        }
+  void NoteFindHandler::on_insert_text(const Gtk::TextIter & pos, const Glib::ustring & text, int)
+  {
+    // pos is at the end of inserted text now
+    const int length = text.size();
+    const int start = pos.get_offset() - length;
+
+    auto iter = std::lower_bound(m_current_matches.begin(), m_current_matches.end(), start - m_max_word_length, MatchStartLess());
+    while(iter != m_current_matches.end()) {
+      if(iter->end <= start) {
+        ++iter;
+      }
+      else if(iter->start >= start) {
+        iter->start += length;
+        iter->end += length;
+        ++iter;
+      }
+      else {
+        iter = m_current_matches.erase(iter);
       }
     }
+
+    if(m_highlight_start > start) {
+      m_highlight_start += length;
+    }
+    if(m_highlight_end >= start) {
+      m_highlight_end += length;
+    }
+    if(m_changed_start >= start) {
+      m_changed_start += length;
+    }
+    if(m_changed_end >= start) {
+      m_changed_end += length;
+    }
+    mark_changed(start, start + length);
   }
 
 
-  void NoteFindHandler::cleanup_matches()
+  void NoteFindHandler::on_delete_range(const Gtk::TextIter & start_iter, const Gtk::TextIter & end_iter)
   {
-    if (!m_current_matches.empty()) {
-      highlight_matches (false /* unhighlight */);
+    const int start = start_iter.get_offset();
+    const int end = end_iter.get_offset();
+    const int length = end - start;
+
+    auto iter = std::lower_bound(m_current_matches.begin(), m_current_matches.end(), start - m_max_word_length, MatchStartLess());
+    while(iter != m_current_matches.end()) {
+      if(iter->end <= start) {
+        ++iter;
+      }
+      else if(iter->start >= end) {
+        iter->start -= length;
+        iter->end -= length;
+        ++iter;
+      }
+      else {
+        iter = m_current_matches.erase(iter);
+      }
+    }
 
-      for(auto & match : m_current_matches) {
-        match.buffer->delete_mark(match.start_mark);
-        match.buffer->delete_mark(match.end_mark);
+    auto shift = [start, end, length](int & offset) {
+      if(offset >= end) {
+        offset -= length;
       }
+      else if(offset > start) {
+        offset = start;
+      }
+    };
+    shift(m_highlight_start);
+    shift(m_highlight_end);
+    shift(m_changed_start);
+    shift(m_changed_end);
+    mark_changed(start, start);
+  }
 
-      m_current_matches.clear();
+
+  void NoteFindHandler::mark_changed(int start, int end)
+  {
+    if(m_changed_start < 0) {
+      m_changed_start = start;
+      m_changed_end = end;
+    }
+    else {
+      m_changed_start = std::min(m_changed_start, start);
+      m_changed_end = std::max(m_changed_end, end);
     }
+    m_note_changed_timeout.reset(FIND_RESCAN_TIMEOUT);
   }
 
 
-
-  void NoteFindHandler::find_matches_in_buffer(const Glib::RefPtr<NoteBuffer> & buffer, 
-                                               const std::vector<Glib::ustring> & words,
-                                               std::vector<NoteFindHandler::Match> & matches)
+  void NoteFindHandler::update_highlighting()
   {
-    matches.clear();
-    Glib::ustring note_text = buffer->get_slice (buffer->begin(),
-                                               buffer->end(),
-                                               false /* hidden_chars */);
-    note_text = note_text.lowercase();
+    NoteWindow *window = m_note.get_window();
+    if(m_current_matches.empty() || !window) {
+      return;
+    }
 
-    for(std::vector<Glib::ustring>::const_iterator iter = words.begin();
-        iter != words.end(); ++iter) {
-      const Glib::ustring & word(*iter);
-      Glib::ustring::size_type idx = 0;
-      bool this_word_found = false;
+    Gtk::TextView *editor = window->editor();
+    Gdk::Rectangle rect;
+    editor->get_visible_rect(rect);
+    Gtk::TextIter iter;
+    editor->get_iter_at_location(iter, rect.get_x(), rect.get_y());
+    int visible_start = iter.get_offset();
+    editor->get_iter_at_location(iter, rect.get_x() + rect.get_width(), rect.get_y() + rect.get_height());
+    iter.forward_to_line_end();
+    int visible_end = iter.get_offset();
+    if(m_highlight_start <= visible_start && visible_end <= m_highlight_end) {
+      return;
+    }
 
-      if (word.empty())
-        continue;
-
-      while(true) {
-        idx = note_text.find(word, idx);
-        if (idx == Glib::ustring::npos) {
-          if (this_word_found) {
-            break;
-          }
-          else {
-            matches.clear();
-            return;
-          }
-        }
+    unhighlight();
+    // a screen above and below, so that scrolling a bit needs no work
+    editor->get_iter_at_location(iter, rect.get_x(), rect.get_y() - rect.get_height());
+    m_highlight_start = iter.get_offset();
+    editor->get_iter_at_location(iter, rect.get_x() + rect.get_width(), rect.get_y() + 2 * rect.get_height());
+    iter.forward_to_line_end();
+    m_highlight_end = iter.get_offset();
+
+    Glib::RefPtr<NoteBuffer> buffer = m_note.get_buffer();
+    auto match = std::lower_bound(m_current_matches.begin(), m_current_matches.end(), m_highlight_start - m_max_word_length, MatchStartLess());
+    for(; match != m_current_matches.end() && match->start < m_highlight_end; ++match) {
+      if(match->end > m_highlight_start) {
+        buffer->apply_tag_by_name("find-match", buffer->get_iter_at_offset(std::max(match->start, m_highlight_start)),
+                                  buffer->get_iter_at_offset(std::min(match->end, m_highlight_end)));
+      }
+    }
+  }
 
-        this_word_found = true;
 
-        Gtk::TextIter start = buffer->get_iter_at_offset(idx);
-        Gtk::TextIter end = start;
-        end.forward_chars(word.length());
+  void NoteFindHandler::unhighlight()
+  {
+    if(m_highlight_start < m_highlight_end) {
+      Glib::RefPtr<NoteBuffer> buffer = m_note.get_buffer();
+      buffer->remove_tag_by_name("find-match", buffer->get_iter_at_offset(m_highlight_start), buffer->get_iter_at_offset(m_highlight_end));
+    }
+    m_highlight_start = m_highlight_end = 0;
+  }
+
 
-        Match match;
-        match.buffer = buffer;
-        match.start_mark = buffer->create_mark(start, false);
-        match.end_mark = buffer->create_mark(end, true);
-        match.highlighting = false;
+  void NoteFindHandler::cleanup_matches()
+  {
+    for(auto & cid : m_signal_cids) {
+      cid.disconnect();
+    }
+    m_signal_cids.clear();
+    m_note_changed_timeout.cancel();
+    m_changed_start = m_changed_end = -1;
+
+    unhighlight();
+    m_current_matches.clear();
+    m_words.clear();
+    m_max_word_length = 0;
+  }
 
-        matches.push_back(match);
 
-        idx += word.length();
+  // Appends matches between start and end offsets, sorted by start.
+  // Returns true if every word was found.
+  bool NoteFindHandler::find_matches_in_buffer(const Glib::RefPtr<NoteBuffer> & buffer, int start, int end,
+                                               std::vector<NoteFindHandler::Match> & matches)
+  {
+    // hidden chars keep slice offsets in line with buffer offsets
+    Glib::ustring note_text = buffer->get_slice(buffer->get_iter_at_offset(start),
+                                                buffer->get_iter_at_offset(end),
+                                                true /* hidden_chars */);
+    note_text = note_text.lowercase();
+    // search bytes, UTF-8 can only match on character boundary, converting offsets as we go
+    const std::string & raw_text = note_text.raw();
+
+    auto first_match = matches.size();
+    bool all_found = true;
+    for(const auto & word : m_words) {
+      const std::string & raw_word = word.raw();
+      const int word_length = word.size();
+      std::string::size_type byte_offset = 0;
+      int char_offset = 0;
+      bool this_word_found = false;
+      for(auto idx = raw_text.find(raw_word); idx != std::string::npos; idx = raw_text.find(raw_word, idx + raw_word.size())) {
+        char_offset += g_utf8_pointer_to_offset(raw_text.data() + byte_offset, raw_text.data() + idx);
+        byte_offset = idx;
+        matches.push_back(Match{start + char_offset, start + char_offset + word_length});
+        this_word_found = true;
       }
+      all_found = all_found && this_word_found;
     }
+
+    std::sort(matches.begin() + first_match, matches.end(), MatchStartLess());
+    return all_found;
   }
 
 
@@ -61,16 +61,16 @@ class NoteFindHandler
 {
 public:
   NoteFindHandler(Note & );
+  ~NoteFindHandler();
   void perform_search(const Glib::ustring & text);
   bool goto_next_result();
   bool goto_previous_result();
 private:
+  // character offsets in note buffer, kept up to date on edits
   struct Match
   {
-    Glib::RefPtr<NoteBuffer>     buffer;
-    Glib::RefPtr<Gtk::TextMark>  start_mark;
-    Glib::RefPtr<Gtk::TextMark>  end_mark;
-    bool                         highlighting;
+    int start;
+    int end;
   };
 
   void jump_to_match(const Match & match);
@@ -78,14 +78,28 @@ private:
   void update_sensitivity();
   void update_search();
   void note_changed_timeout();
-  void highlight_matches(bool);
+  void on_insert_text(const Gtk::TextIter & pos, const Glib::ustring & text, int);
+  void on_delete_range(const Gtk::TextIter & start, const Gtk::TextIter & end);
+  void mark_changed(int start, int end);
+  void update_highlighting();
+  void unhighlight();
   void cleanup_matches();
-  void find_matches_in_buffer(const Glib::RefPtr<NoteBuffer> & buffer, 
-                              const std::vector<Glib::ustring> & words,
+  bool find_matches_in_buffer(const Glib::RefPtr<NoteBuffer> & buffer, int start, int end,
                               std::vector<Match> & matches);
 
   Note           & m_note;
+  std::vector<Glib::ustring> m_words;
+  int m_max_word_length;
+  // sorted by start
   std::vector<Match> m_current_matches;
+  // matches in this range have find-match tag applied, it covers visible area with some margin
+  int m_highlight_start;
+  int m_highlight_end;
+  // region edited since last rescan, empty when start is -1
+  int m_changed_start;
+  int m_changed_end;
+  utils::InterruptableTimeout m_note_changed_timeout;
+  std::vector<sigc::connection> m_signal_cids;
 };
 
 class NoteWindow 
@@ -143,6 +157,7 @@ public:
 private:
   void connect_actions(EmbeddableWidgetHost *host);
   void disconnect_actions();
+  void on_deferred_action_activated(const Glib::VariantBase & parameter, const Glib::ustring & action_name);
   void on_delete_button_clicked(const Glib::VariantBase&);
   Glib::RefPtr<Gio::MenuModel> editor_extra_menu();
   Gtk::Grid *make_toolbar();
@@ -12,6 +12,7 @@
 <xsl:param name="export-linked" />
 <xsl:param name="export-linked-all" />
 <xsl:param name="root-note" />
+<xsl:param name="link-base" />
 
 <xsl:param name="newline" select="'&#xA;'" />
 
@@ -130,9 +131,18 @@
 </xsl:template>
 
 <xsl:template match="link:internal">
-	<a style="color:#204A87" href="#{tomboy:ToLower(node())}">
-		<xsl:value-of select="node()"/>
-	</a>
+	<xsl:choose>
+		<xsl:when test="$link-base">
+			<a style="color:#204A87" href="{$link-base}{tomboy:EncodeUri(string(node()))}">
+				<xsl:value-of select="node()"/>
+			</a>
+		</xsl:when>
+		<xsl:otherwise>
+			<a style="color:#204A87" href="#{tomboy:ToLower(node())}">
+				<xsl:value-of select="node()"/>
+			</a>
+		</xsl:otherwise>
+	</xsl:choose>
 </xsl:template>
 
 <xsl:template match="link:url">
@@ -20,8 +20,6 @@
 
 
 #include <libxml/xmlmemory.h>
-#include <libxml/xpathInternals.h>
-#include <libxslt/extensions.h>
 
 #include <glibmm/i18n.h>
 
@@ -35,16 +33,15 @@
 #include "debug.hpp"
 #include "iactionmanager.hpp"
 #include "ignote.hpp"
+#include "notehtmlrenderer.hpp"
 #include "preferences.hpp"
+#include "tracing.hpp"
 #include "notewindow.hpp"
 #include "utils.hpp"
 
 #include "exporttohtmlnoteaddin.hpp"
 #include "notenameresolver.hpp"
 
-#define STYLESHEET_NAME "exporttohtml.xsl"
-
-
 using gnote::Preferences;
 
 namespace exporttohtml {
@@ -55,9 +52,6 @@ ExportToHtmlModule::ExportToHtmlModule()
   ADD_INTERFACE_IMPL(ExportToHtmlNoteAddin);
 }
 
-sharp::XslTransform *ExportToHtmlNoteAddin::s_xsl = NULL;
-
-
 void ExportToHtmlNoteAddin::initialize()
 {
   
@@ -178,75 +172,19 @@ void ExportToHtmlNoteAddin::export_dialog_response(ExportToHtmlDialog & dialog)
 
 
 
-static void to_lower(xmlXPathParserContextPtr ctxt,
-                     int)
-{
-  const xmlChar *input = xmlXPathPopString(ctxt);
-  gchar * lower = g_utf8_strdown((const gchar*)input, -1);
-  xmlXPathReturnString(ctxt, xmlStrdup((const xmlChar*)lower));
-  g_free(lower);
-}
-
-
-sharp::XslTransform & ExportToHtmlNoteAddin::get_note_xsl()
-{
-  if(s_xsl == NULL) {
-    int result = xsltRegisterExtModuleFunction((const xmlChar *)"ToLower",
-                                               (const xmlChar *)"http://beatniksoftware.com/tomboy", 
-                                               &to_lower);
-    DBG_OUT("xsltRegisterExtModule %d", result);
-    if(result == -1) {
-      DBG_OUT("xsltRegisterExtModule failed");
-    }
-
-    s_xsl = new sharp::XslTransform;
-    Glib::ustring stylesheet_file = DATADIR "/gnote/" STYLESHEET_NAME;
-
-    if (sharp::file_exists (stylesheet_file)) {
-      DBG_OUT("ExportToHTML: Using user-custom %s file.", STYLESHEET_NAME);
-      s_xsl->load(stylesheet_file);
-    } 
-#if 0
-    else {
-      Stream resource = asm.GetManifestResourceStream (stylesheet_name);
-      if (resource != null) {
-        XmlTextReader reader = new XmlTextReader (resource);
-        s_xsl->load (reader, null, null);
-        resource.Close ();
-      } 
-      else {
-        DBG_OUT("Unable to find HTML export template '%s'.", STYLESHEET_NAME);
-      }
-    }
-#endif
-
-  }
-  return *s_xsl;
-}
-
-
 void ExportToHtmlNoteAddin::write_html_for_note(sharp::StreamWriter & writer,
   gnote::Note & note, bool export_linked, bool export_linked_all)
 {
+  TRACE_SPAN("export_html");
   Glib::ustring s_writer;
   s_writer = note.manager().note_archiver().write_string(note.data());
   xmlDocPtr doc = xmlParseMemory(s_writer.c_str(), s_writer.bytes());
 
-  sharp::XsltArgumentList args;
-  args.add_param("export-linked", "", export_linked);
-  args.add_param("export-linked-all", "", export_linked_all);
-  args.add_param("root-note", "", gnote::utils::XmlEncoder::encode(note.get_title()));
-
-  if(ignote().preferences().enable_custom_font()) {
-    Glib::ustring font_face = ignote().preferences().custom_font_face();
-    Pango::FontDescription font_desc (font_face);
-    Glib::ustring font = Glib::ustring::compose("font-family:'%1';", font_desc.get_family());
-
-    args.add_param ("font", "", font);
-  }
+  sharp::XsltArgumentList args = gnote::html::note_xsl_args(note.get_title(),
+    gnote::html::note_font_css(ignote().preferences()), export_linked, export_linked_all);
 
   NoteNameResolver resolver(note.manager(), note);
-  get_note_xsl().transform(doc, args, writer, resolver);
+  gnote::html::note_xsl().transform(doc, args, writer, resolver);
 
   xmlFreeDoc(doc);
 }
@@ -28,7 +28,6 @@
 
 #include "sharp/dynamicmodule.hpp"
 #include "sharp/streamwriter.hpp"
-#include "sharp/xsltransform.hpp"
 #include "exporttohtmldialog.hpp"
 #include "note.hpp"
 #include "noteaddin.hpp"
@@ -59,12 +58,9 @@ public:
   virtual void on_note_opened() override;
   virtual std::vector<gnote::PopoverWidget> get_actions_popover_widgets() const override;
 private:
-  sharp::XslTransform & get_note_xsl();
   void export_button_clicked(const Glib::VariantBase&);
   void export_dialog_response(ExportToHtmlDialog & dialog);
   void write_html_for_note(sharp::StreamWriter &, gnote::Note &, bool, bool);
-
-  static sharp::XslTransform *s_xsl;
 };
 
 }
@@ -0,0 +1,125 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glibmm/i18n.h>
+
+#include "debug.hpp"
+#include "iactionmanager.hpp"
+#include "ignote.hpp"
+#include "mainwindow.hpp"
+#include "utils.hpp"
+#include "htmlpreviewapplicationaddin.hpp"
+
+
+namespace htmlpreview {
+
+namespace {
+
+const char *SCHEMA_EXPORT_HTML = "org.gnome.gnote.export-html";
+const char *PREVIEW_PORT = "preview-port";
+const char *PREVIEW_CACHE_SIZE = "preview-cache-size";
+
+}
+
+
+HtmlPreviewModule::HtmlPreviewModule()
+{
+  ADD_INTERFACE_IMPL(HtmlPreviewApplicationAddin);
+}
+
+
+
+HtmlPreviewApplicationAddin::HtmlPreviewApplicationAddin()
+  : m_initialized(false)
+{
+}
+
+void HtmlPreviewApplicationAddin::initialize()
+{
+  if(!m_initialized) {
+    m_initialized = true;
+    m_settings = Gio::Settings::create(SCHEMA_EXPORT_HTML);
+    m_settings_changed_cid = m_settings->signal_changed()
+      .connect(sigc::mem_fun(*this, &HtmlPreviewApplicationAddin::on_settings_changed));
+    start_server();
+
+    auto & manager(ignote().action_manager());
+    manager.register_main_window_search_callback("htmlpreview-open-cback",
+      "htmlpreview-open", sigc::mem_fun(*this, &HtmlPreviewApplicationAddin::on_open_preview));
+    m_add_menu_item_cid = manager.signal_build_main_window_search_popover
+      .connect(sigc::mem_fun(*this, &HtmlPreviewApplicationAddin::add_menu_item));
+  }
+}
+
+void HtmlPreviewApplicationAddin::shutdown()
+{
+  auto & manager(ignote().action_manager());
+  manager.unregister_main_window_search_callback("htmlpreview-open-cback");
+  m_add_menu_item_cid.disconnect();
+  m_settings_changed_cid.disconnect();
+  m_server.reset();
+  m_settings.reset();
+  m_initialized = false;
+}
+
+bool HtmlPreviewApplicationAddin::initialized()
+{
+  return m_initialized;
+}
+
+void HtmlPreviewApplicationAddin::start_server()
+{
+  m_server.reset();
+  int port = m_settings->get_int(PREVIEW_PORT);
+  int cache_size = m_settings->get_int(PREVIEW_CACHE_SIZE);
+  auto server = std::make_unique<HtmlPreviewServer>(ignote(), note_manager(), cache_size);
+  try {
+    server->start(port);
+    m_server = std::move(server);
+  }
+  catch(Glib::Error & e) {
+    ERR_OUT(_("Failed to start HTML preview server on port %d: %s"), port, e.what());
+  }
+}
+
+void HtmlPreviewApplicationAddin::on_settings_changed(const Glib::ustring & key)
+{
+  if(key == PREVIEW_PORT || key == PREVIEW_CACHE_SIZE) {
+    start_server();
+  }
+}
+
+void HtmlPreviewApplicationAddin::add_menu_item(std::vector<gnote::PopoverWidget> & widgets)
+{
+  auto item = Gio::MenuItem::create(_("Open HTML Preview"), "win.htmlpreview-open");
+  widgets.push_back(gnote::PopoverWidget::create_for_app(110, item));
+}
+
+void HtmlPreviewApplicationAddin::on_open_preview(const Glib::VariantBase&)
+{
+  if(!m_server) {
+    start_server();
+  }
+  if(m_server) {
+    gnote::utils::open_url(ignote().get_main_window(), m_server->url());
+  }
+}
+
+}
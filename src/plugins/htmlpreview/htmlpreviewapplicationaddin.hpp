@@ -0,0 +1,68 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _HTMLPREVIEW_APPLICATION_ADDIN_
+#define _HTMLPREVIEW_APPLICATION_ADDIN_
+
+#include <memory>
+
+#include <giomm/settings.h>
+
+#include "applicationaddin.hpp"
+#include "htmlpreviewserver.hpp"
+#include "sharp/dynamicmodule.hpp"
+
+namespace htmlpreview {
+
+class HtmlPreviewModule
+  : public sharp::DynamicModule
+{
+public:
+  HtmlPreviewModule();
+};
+
+DECLARE_MODULE(HtmlPreviewModule);
+
+class HtmlPreviewApplicationAddin
+  : public gnote::ApplicationAddin
+{
+public:
+  static HtmlPreviewApplicationAddin *create()
+    {
+      return new HtmlPreviewApplicationAddin;
+    }
+  virtual void initialize() override;
+  virtual void shutdown() override;
+  virtual bool initialized() override;
+private:
+  HtmlPreviewApplicationAddin();
+  void start_server();
+  void on_settings_changed(const Glib::ustring & key);
+  void on_open_preview(const Glib::VariantBase&);
+  void add_menu_item(std::vector<gnote::PopoverWidget> & widgets);
+
+  bool m_initialized;
+  Glib::RefPtr<Gio::Settings> m_settings;
+  std::unique_ptr<HtmlPreviewServer> m_server;
+  sigc::connection m_settings_changed_cid;
+  sigc::connection m_add_menu_item_cid;
+};
+
+}
+
+#endif
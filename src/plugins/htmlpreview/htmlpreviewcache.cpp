@@ -0,0 +1,140 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstdio>
+
+#include "htmlpreviewcache.hpp"
+
+
+namespace htmlpreview {
+
+namespace {
+
+std::string page_etag(const Glib::ustring & uri, gint64 changed, const Glib::ustring & font)
+{
+  char etag[64];
+  std::snprintf(etag, sizeof(etag), "\"%zx-%llx-%zx\"", gnote::Hash<Glib::ustring>()(uri),
+                static_cast<unsigned long long>(changed), gnote::Hash<Glib::ustring>()(font));
+  return etag;
+}
+
+}
+
+
+Page::Page(const Glib::ustring & uri, gint64 change_date, const Glib::ustring & font_css, std::string && page_html)
+  : changed(change_date)
+  , font(font_css)
+  , etag(page_etag(uri, change_date, font_css))
+  , html(std::move(page_html))
+  , gzipped(gzip(html))
+{
+}
+
+
+std::size_t Page::bytes() const
+{
+  return sizeof(Page) + font.bytes() + etag.size() + html.size() + gzipped.size();
+}
+
+
+HttpResponse page_response(const HttpRequest & request, const Page & page)
+{
+  HttpResponse response;
+  response.etag = page.etag;
+  response.cacheable = true;
+  if(etag_matches(request, page.etag)) {
+    response.status = 304;
+  }
+  else if(!page.gzipped.empty() && accepts_gzip(request)) {
+    response.body = page.gzipped;
+    response.gzipped = true;
+  }
+  else {
+    response.body = page.html;
+  }
+  return response;
+}
+
+
+PageCache::PageCache(std::size_t capacity)
+  : m_capacity(std::max<std::size_t>(capacity, 1))
+  , m_memory(gnote::memory::Category::CACHES)
+{
+}
+
+
+PageCache::PagePtr PageCache::get(const Glib::ustring & uri, gint64 changed, const Glib::ustring & font)
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  auto iter = m_pages.find(uri);
+  if(iter == m_pages.end()) {
+    return PagePtr();
+  }
+  const PagePtr & page = iter->second->second;
+  if(page->changed != changed || page->font != font) {
+    return PagePtr();
+  }
+  m_lru.splice(m_lru.begin(), m_lru, iter->second);
+  return page;
+}
+
+
+void PageCache::put(const Glib::ustring & uri, const PagePtr & page)
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  auto iter = m_pages.find(uri);
+  if(iter != m_pages.end()) {
+    erase(iter->second);
+  }
+  m_lru.emplace_front(uri, page);
+  m_pages[uri] = m_lru.begin();
+  m_memory.set(m_memory.bytes() + uri.bytes() + page->bytes());
+  while(m_lru.size() > m_capacity) {
+    erase(std::prev(m_lru.end()));
+  }
+}
+
+
+void PageCache::remove(const Glib::ustring & uri)
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  auto iter = m_pages.find(uri);
+  if(iter != m_pages.end()) {
+    erase(iter->second);
+  }
+}
+
+
+std::size_t PageCache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_lru.size();
+}
+
+
+void PageCache::erase(LruList::iterator iter)
+{
+  m_memory.set(m_memory.bytes() - iter->first.bytes() - iter->second->bytes());
+  m_pages.erase(iter->first);
+  m_lru.erase(iter);
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _HTMLPREVIEW_CACHE_HPP_
+#define _HTMLPREVIEW_CACHE_HPP_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <glibmm/ustring.h>
+
+#include "memoryusage.hpp"
+#include "base/hash.hpp"
+#include "htmlpreviewhttp.hpp"
+
+
+namespace htmlpreview {
+
+/// Note rendered to HTML, valid as long as note change date and font stay the same.
+struct Page
+{
+  Page(const Glib::ustring & uri, gint64 change_date, const Glib::ustring & font_css, std::string && page_html);
+
+  std::size_t bytes() const;
+
+  const gint64 changed;
+  const Glib::ustring font;
+  const std::string etag;
+  const std::string html;
+  // empty if compression failed
+  const std::string gzipped;
+};
+
+/// 304 if client has the page, otherwise page in the encoding client accepts.
+HttpResponse page_response(const HttpRequest & request, const Page & page);
+
+
+/// Least recently used rendered pages, keyed by note URI. Thread safe.
+class PageCache
+{
+public:
+  typedef std::shared_ptr<const Page> PagePtr;
+
+  explicit PageCache(std::size_t capacity);
+
+  /// Cached page, if it is still valid for the note.
+  PagePtr get(const Glib::ustring & uri, gint64 changed, const Glib::ustring & font);
+  void put(const Glib::ustring & uri, const PagePtr & page);
+  void remove(const Glib::ustring & uri);
+  std::size_t size() const;
+private:
+  typedef std::list<std::pair<Glib::ustring, PagePtr>> LruList;
+
+  void erase(LruList::iterator iter);
+
+  const std::size_t m_capacity;
+  mutable std::mutex m_lock;
+  LruList m_lru;
+  std::unordered_map<Glib::ustring, LruList::iterator, gnote::Hash<Glib::ustring>> m_pages;
+  gnote::memory::Tracker m_memory;
+};
+
+}
+
+#endif
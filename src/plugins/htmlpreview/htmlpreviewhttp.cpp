@@ -0,0 +1,275 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstring>
+
+#include <gio/gio.h>
+
+#include "htmlpreviewhttp.hpp"
+
+
+namespace htmlpreview {
+
+namespace {
+
+const gsize MAX_REQUEST_SIZE = 16384;
+const char *HEAD_END = "\r\n\r\n";
+
+
+std::string lower(std::string s)
+{
+  for(auto & c : s) {
+    c = g_ascii_tolower(c);
+  }
+  return s;
+}
+
+
+std::string trim(const std::string & s)
+{
+  auto start = s.find_first_not_of(" \t");
+  if(start == std::string::npos) {
+    return "";
+  }
+  auto end = s.find_last_not_of(" \t");
+  return s.substr(start, end - start + 1);
+}
+
+
+const char *status_text(int status)
+{
+  switch(status) {
+  case 200:
+    return "200 OK";
+  case 304:
+    return "304 Not Modified";
+  case 400:
+    return "400 Bad Request";
+  case 403:
+    return "403 Forbidden";
+  case 404:
+    return "404 Not Found";
+  case 405:
+    return "405 Method Not Allowed";
+  case 503:
+    return "503 Service Unavailable";
+  default:
+    return "500 Internal Server Error";
+  }
+}
+
+}
+
+
+bool parse_request(const std::string & head, HttpRequest & request)
+{
+  if(head.size() > MAX_REQUEST_SIZE) {
+    return false;
+  }
+  auto end = head.find(HEAD_END);
+  if(end == std::string::npos) {
+    return false;
+  }
+
+  auto line_end = head.find("\r\n");
+  std::string line = head.substr(0, line_end);
+  auto method_end = line.find(' ');
+  if(method_end == std::string::npos) {
+    return false;
+  }
+  auto path_end = line.find(' ', method_end + 1);
+  if(path_end == std::string::npos || line.compare(path_end + 1, 5, "HTTP/") != 0) {
+    return false;
+  }
+  request.method = line.substr(0, method_end);
+  request.path = line.substr(method_end + 1, path_end - method_end - 1);
+  auto query = request.path.find_first_of("?#");
+  if(query != std::string::npos) {
+    request.path.resize(query);
+  }
+  if(request.path.empty() || request.path[0] != '/') {
+    return false;
+  }
+
+  while(line_end < end) {
+    auto start = line_end + 2;
+    line_end = head.find("\r\n", start);
+    line = head.substr(start, line_end - start);
+    auto colon = line.find(':');
+    if(colon == std::string::npos || colon == 0) {
+      continue;
+    }
+    request.headers[lower(line.substr(0, colon))] = trim(line.substr(colon + 1));
+  }
+  return true;
+}
+
+
+bool read_request(const Glib::RefPtr<Gio::InputStream> & input, HttpRequest & request)
+{
+  std::string head;
+  char buffer[4096];
+  // body of GET and HEAD is never looked at, so reading past the empty line is harmless
+  while(head.find(HEAD_END) == std::string::npos) {
+    if(head.size() >= MAX_REQUEST_SIZE) {
+      return false;
+    }
+    gssize count = input->read(buffer, std::min(sizeof(buffer), MAX_REQUEST_SIZE - head.size()));
+    if(count <= 0) {
+      return false;
+    }
+    head.append(buffer, count);
+  }
+  head.resize(head.find(HEAD_END) + strlen(HEAD_END));
+  return parse_request(head, request);
+}
+
+
+bool is_local_host(const HttpRequest & request, guint16 port)
+{
+  // reject requests for other host names, pages of other sites could otherwise read notes
+  // by resolving their own name to loopback address
+  auto host = request.headers.find("host");
+  if(host == request.headers.end()) {
+    return false;
+  }
+  std::string suffix = ":" + std::to_string(port);
+  std::string value = lower(host->second);
+  return value == "127.0.0.1" + suffix || value == "localhost" + suffix;
+}
+
+
+bool etag_matches(const HttpRequest & request, const std::string & etag)
+{
+  auto if_none_match = request.headers.find("if-none-match");
+  if(if_none_match == request.headers.end()) {
+    return false;
+  }
+  std::string value = if_none_match->second;
+  std::string::size_type start = 0;
+  while(start <= value.size()) {
+    auto end = value.find(',', start);
+    if(end == std::string::npos) {
+      end = value.size();
+    }
+    std::string tag = trim(value.substr(start, end - start));
+    // weak comparison is fine for GET
+    if(tag.compare(0, 2, "W/") == 0) {
+      tag = tag.substr(2);
+    }
+    if(tag == "*" || tag == etag) {
+      return true;
+    }
+    start = end + 1;
+  }
+  return false;
+}
+
+
+bool accepts_gzip(const HttpRequest & request)
+{
+  auto accept_encoding = request.headers.find("accept-encoding");
+  if(accept_encoding == request.headers.end()) {
+    return false;
+  }
+  std::string value = lower(accept_encoding->second);
+  std::string::size_type start = 0;
+  while(start <= value.size()) {
+    auto end = value.find(',', start);
+    if(end == std::string::npos) {
+      end = value.size();
+    }
+    std::string coding = value.substr(start, end - start);
+    auto params = coding.find(';');
+    if(trim(coding.substr(0, params)) == "gzip") {
+      if(params == std::string::npos) {
+        return true;
+      }
+      auto q = coding.find("q=", params);
+      return q == std::string::npos || g_ascii_strtod(coding.c_str() + q + 2, NULL) > 0;
+    }
+    start = end + 1;
+  }
+  return false;
+}
+
+
+std::string gzip(const std::string & data)
+{
+  GZlibCompressor *compressor = g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1);
+  std::string out;
+  char buffer[16384];
+  gsize in_pos = 0;
+  bool done = false;
+  while(!done) {
+    gsize read = 0, written = 0;
+    GConverterResult result = g_converter_convert(G_CONVERTER(compressor),
+      data.data() + in_pos, data.size() - in_pos, buffer, sizeof(buffer),
+      G_CONVERTER_INPUT_AT_END, &read, &written, NULL);
+    if(result == G_CONVERTER_ERROR) {
+      out.clear();
+      break;
+    }
+    in_pos += read;
+    out.append(buffer, written);
+    done = result == G_CONVERTER_FINISHED;
+  }
+  g_object_unref(compressor);
+  return out;
+}
+
+
+bool response_has_body(const HttpResponse & response)
+{
+  return response.status != 304;
+}
+
+
+std::string response_head(const HttpResponse & response)
+{
+  std::string head = "HTTP/1.1 ";
+  head += status_text(response.status);
+  head += "\r\n";
+  if(response.status == 405) {
+    head += "Allow: GET, HEAD\r\n";
+  }
+  if(response_has_body(response)) {
+    head += "Content-Type: text/html; charset=utf-8\r\n";
+    head += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+  }
+  if(!response.etag.empty()) {
+    head += "ETag: " + response.etag + "\r\n";
+  }
+  if(response.cacheable) {
+    // revalidate every time, ETag makes it cheap
+    head += "Cache-Control: no-cache\r\nVary: Accept-Encoding\r\n";
+  }
+  else {
+    head += "Cache-Control: no-store\r\n";
+  }
+  if(response.gzipped) {
+    head += "Content-Encoding: gzip\r\n";
+  }
+  head += "Connection: close\r\n\r\n";
+  return head;
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _HTMLPREVIEW_HTTP_HPP_
+#define _HTMLPREVIEW_HTTP_HPP_
+
+#include <string>
+#include <unordered_map>
+
+#include <giomm/inputstream.h>
+
+
+namespace htmlpreview {
+
+struct HttpRequest
+{
+  std::string method;
+  // without query
+  std::string path;
+  // names in lower case
+  std::unordered_map<std::string, std::string> headers;
+};
+
+struct HttpResponse
+{
+  int status = 200;
+  std::string etag;
+  std::string body;
+  bool gzipped = false;
+  // client may keep the page, but has to revalidate it
+  bool cacheable = false;
+};
+
+/// Request line and headers, up to the empty line. Requests without it or too long are malformed.
+bool parse_request(const std::string & head, HttpRequest & request);
+/// Reads and parses request head, never reading more than a few kilobytes. Throws Glib::Error on I/O errors.
+bool read_request(const Glib::RefPtr<Gio::InputStream> & input, HttpRequest & request);
+
+/// Host header names loopback address with the given port.
+bool is_local_host(const HttpRequest & request, guint16 port);
+bool etag_matches(const HttpRequest & request, const std::string & etag);
+bool accepts_gzip(const HttpRequest & request);
+
+/// Empty on failure.
+std::string gzip(const std::string & data);
+
+/// Status line and headers, including the empty line.
+std::string response_head(const HttpResponse & response);
+bool response_has_body(const HttpResponse & response);
+
+}
+
+#endif
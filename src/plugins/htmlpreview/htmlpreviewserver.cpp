@@ -0,0 +1,319 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <atomic>
+#include <cstring>
+
+#include <giomm/inetsocketaddress.h>
+
+#include "debug.hpp"
+#include "itagmanager.hpp"
+#include "notehtmlrenderer.hpp"
+#include "utils.hpp"
+
+#include "htmlpreviewcache.hpp"
+#include "htmlpreviewhttp.hpp"
+#include "htmlpreviewserver.hpp"
+
+
+namespace htmlpreview {
+
+namespace {
+
+const int MAX_THREADS = 8;
+const int SOCKET_TIMEOUT = 10;
+const char *NOTE_PATH = "/note/";
+const char *TITLE_PATH = "/title/";
+
+
+bool unescape(const std::string & escaped, Glib::ustring & out)
+{
+  gchar *unescaped = g_uri_unescape_string(escaped.c_str(), NULL);
+  if(!unescaped) {
+    return false;
+  }
+  bool valid = g_utf8_validate(unescaped, -1, NULL);
+  if(valid) {
+    out = unescaped;
+  }
+  g_free(unescaped);
+  return valid;
+}
+
+}
+
+
+/// Everything shared with worker threads. Kept alive by running connection handlers,
+/// so that stopping the server never waits for them.
+class HtmlPreviewServer::State
+  : public std::enable_shared_from_this<HtmlPreviewServer::State>
+{
+public:
+  State(gnote::IGnote & g, gnote::NoteManager & manager, unsigned cache_size)
+    : m_port(0)
+    , m_stopped(false)
+    , m_gnote(g)
+    , m_manager(manager)
+    , m_cache(cache_size)
+    {}
+
+  bool handle_connection(const Glib::RefPtr<Gio::SocketConnection> & connection);
+  void forget(const Glib::ustring & uri)
+    {
+      m_cache.remove(uri);
+    }
+
+  std::atomic<guint16> m_port;
+  std::atomic<bool> m_stopped;
+private:
+  HttpResponse respond(const HttpRequest & request);
+  HttpResponse respond_index();
+  HttpResponse respond_note(const HttpRequest & request, bool by_title, const Glib::ustring & key);
+
+  gnote::IGnote & m_gnote;
+  gnote::NoteManager & m_manager;
+  PageCache m_cache;
+};
+
+
+bool HtmlPreviewServer::State::handle_connection(const Glib::RefPtr<Gio::SocketConnection> & connection)
+{
+  auto self = shared_from_this();
+  HttpRequest request;
+  HttpResponse response;
+  try {
+    connection->get_socket()->set_timeout(SOCKET_TIMEOUT);
+    if(!read_request(connection->get_input_stream(), request)) {
+      response.status = 400;
+    }
+  }
+  catch(Glib::Error & e) {
+    DBG_OUT("Failed to read HTML preview request: %s", e.what());
+    return true;
+  }
+
+  if(response.status == 200) {
+    // exceptions must not leave the worker thread
+    try {
+      response = respond(request);
+    }
+    catch(Glib::Error & e) {
+      ERR_OUT("Failed to answer HTML preview request %s: %s", request.path.c_str(), e.what());
+      response = HttpResponse();
+      response.status = 500;
+    }
+    catch(std::exception & e) {
+      ERR_OUT("Failed to answer HTML preview request %s: %s", request.path.c_str(), e.what());
+      response = HttpResponse();
+      response.status = 500;
+    }
+  }
+
+  try {
+    auto output = connection->get_output_stream();
+    std::string head = response_head(response);
+    gsize written = 0;
+    output->write_all(head.data(), head.size(), written);
+    if(response_has_body(response) && request.method != "HEAD" && !response.body.empty()) {
+      output->write_all(response.body.data(), response.body.size(), written);
+    }
+    connection->close();
+  }
+  catch(Glib::Error & e) {
+    DBG_OUT("Failed to send HTML preview response: %s", e.what());
+  }
+  catch(std::exception & e) {
+    DBG_OUT("Failed to send HTML preview response: %s", e.what());
+  }
+  return true;
+}
+
+
+HttpResponse HtmlPreviewServer::State::respond(const HttpRequest & request)
+{
+  HttpResponse response;
+  if(request.method != "GET" && request.method != "HEAD") {
+    response.status = 405;
+  }
+  else if(!is_local_host(request, m_port)) {
+    response.status = 403;
+  }
+  else if(m_stopped) {
+    response.status = 503;
+  }
+  else if(request.path == "/") {
+    response = respond_index();
+  }
+  else {
+    bool by_title = request.path.compare(0, strlen(TITLE_PATH), TITLE_PATH) == 0;
+    bool by_id = request.path.compare(0, strlen(NOTE_PATH), NOTE_PATH) == 0;
+    Glib::ustring key;
+    if(by_title && unescape(request.path.substr(strlen(TITLE_PATH)), key)) {
+      response = respond_note(request, true, key);
+    }
+    else if(by_id && unescape(request.path.substr(strlen(NOTE_PATH)), key)) {
+      response = respond_note(request, false, key);
+    }
+    else {
+      response.status = 404;
+    }
+  }
+  return response;
+}
+
+
+HttpResponse HtmlPreviewServer::State::respond_index()
+{
+  HttpResponse response;
+  gnote::utils::main_context_call([this, &response] {
+    if(m_stopped) {
+      response.status = 503;
+      return;
+    }
+    auto template_tag = m_manager.tag_manager().get_system_tag(gnote::ITagManager::TEMPLATE_NOTE_SYSTEM_TAG);
+    Glib::ustring body = "<html><head><meta charset=\"utf-8\"/><title>Gnote</title></head><body><ul>\n";
+    m_manager.for_each_by_change_date([&body, &template_tag](gnote::NoteBase & note) {
+      if(template_tag && note.contains_tag(template_tag)) {
+        return;
+      }
+      gchar *id = g_uri_escape_string(note.id().c_str(), NULL, TRUE);
+      body += Glib::ustring::compose("<li><a href=\"%1%2\">%3</a></li>\n", NOTE_PATH, id,
+                                     gnote::utils::XmlEncoder::encode(note.get_title()));
+      g_free(id);
+    });
+    body += "</ul></body></html>\n";
+    response.body = body.raw();
+  });
+  return response;
+}
+
+
+HttpResponse HtmlPreviewServer::State::respond_note(const HttpRequest & request, bool by_title, const Glib::ustring & key)
+{
+  HttpResponse response;
+  Glib::ustring uri, title, font;
+  gint64 changed = 0;
+  std::string xml;
+  PageCache::PagePtr page;
+
+  // only take what is needed from the note on main thread, render on this one
+  gnote::utils::main_context_call([&] {
+    if(m_stopped) {
+      response.status = 503;
+      return;
+    }
+    auto note = by_title ? m_manager.find(key) : m_manager.find_by_uri("note://gnote/" + key);
+    if(!note) {
+      response.status = 404;
+      return;
+    }
+    gnote::NoteBase & n = *note;
+    uri = n.uri();
+    title = n.get_title();
+    changed = n.change_date().to_unix() * G_USEC_PER_SEC + n.change_date().get_microsecond();
+    font = gnote::html::note_font_css(m_gnote.preferences());
+    page = m_cache.get(uri, changed, font);
+    if(!page) {
+      xml = m_manager.note_archiver().write_string(n.data()).raw();
+    }
+  });
+  if(response.status != 200) {
+    return response;
+  }
+
+  if(!page) {
+    std::string html = gnote::html::render_note_html(xml, gnote::html::note_xsl_args(title, font, false, false, TITLE_PATH));
+    if(html.empty()) {
+      response.status = 500;
+      return response;
+    }
+    page = std::make_shared<Page>(uri, changed, font, std::move(html));
+    m_cache.put(uri, page);
+  }
+
+  return page_response(request, *page);
+}
+
+
+
+HtmlPreviewServer::HtmlPreviewServer(gnote::IGnote & g, gnote::NoteManager & manager, unsigned cache_size)
+  : m_state(std::make_shared<State>(g, manager, cache_size))
+  , m_port(0)
+{
+  m_note_deleted_cid = manager.signal_note_deleted.connect([this](gnote::NoteBase & note) {
+    m_state->forget(note.uri());
+  });
+}
+
+
+HtmlPreviewServer::~HtmlPreviewServer()
+{
+  m_note_deleted_cid.disconnect();
+  stop();
+}
+
+
+void HtmlPreviewServer::start(guint16 port)
+{
+  stop();
+  // loads stylesheet and registers its functions, must not happen while workers render
+  gnote::html::note_xsl();
+
+  auto service = Gio::ThreadedSocketService::create(MAX_THREADS);
+  auto address = Gio::InetSocketAddress::create(Gio::InetAddress::create_loopback(Gio::SocketFamily::IPV4), port);
+  Glib::RefPtr<Gio::SocketAddress> effective_address;
+  service->add_address(address, Gio::Socket::Type::STREAM, Gio::Socket::Protocol::TCP, effective_address);
+  auto inet_address = std::dynamic_pointer_cast<Gio::InetSocketAddress>(effective_address);
+  m_port = inet_address ? inet_address->get_port() : port;
+
+  auto state = m_state;
+  state->m_port = m_port;
+  state->m_stopped = false;
+  service->signal_run().connect([state](const Glib::RefPtr<Gio::SocketConnection> & connection, const Glib::RefPtr<Glib::Object> &) {
+    return state->handle_connection(connection);
+  }, false);
+  service->start();
+  m_service = service;
+}
+
+
+void HtmlPreviewServer::stop()
+{
+  if(!m_service) {
+    return;
+  }
+  // running handlers finish with an error page, nothing waits for them
+  m_state->m_stopped = true;
+  m_service->stop();
+  m_service->close();
+  m_service.reset();
+  m_port = 0;
+}
+
+
+Glib::ustring HtmlPreviewServer::url() const
+{
+  if(!m_service) {
+    return "";
+  }
+  return Glib::ustring::compose("http://127.0.0.1:%1/", m_port);
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HTMLPREVIEW_SERVER_HPP_
+#define _HTMLPREVIEW_SERVER_HPP_
+
+#include <memory>
+
+#include <giomm/threadedsocketservice.h>
+
+#include "ignote.hpp"
+#include "notemanager.hpp"
+
+
+namespace htmlpreview {
+
+/// Serves notes rendered to HTML on localhost, rendering them only when requested.
+/// Connections are handled on worker threads. Note data is copied on the main thread,
+/// while rendering, compression and network I/O happen on workers, so slow clients and
+/// large notes do not block the UI. Rendered pages are kept in an LRU cache and validated
+/// with ETags derived from note change date.
+class HtmlPreviewServer
+{
+public:
+  HtmlPreviewServer(gnote::IGnote & g, gnote::NoteManager & manager, unsigned cache_size);
+  ~HtmlPreviewServer();
+
+  /// Listens on loopback interface, 0 picks a free port. Throws Glib::Error on failure.
+  void start(guint16 port);
+  void stop();
+  /// Address of the index page, empty when not running.
+  Glib::ustring url() const;
+private:
+  class State;
+
+  std::shared_ptr<State> m_state;
+  Glib::RefPtr<Gio::ThreadedSocketService> m_service;
+  sigc::connection m_note_deleted_cid;
+  guint16 m_port;
+};
+
+}
+
+#endif
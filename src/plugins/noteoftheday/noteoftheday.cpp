@@ -33,10 +33,97 @@ const Glib::ustring NoteOfTheDay::s_template_title
 const Glib::ustring NoteOfTheDay::s_title_prefix
                                   = _("Today: ");
 
-gnote::NoteBase::ORef NoteOfTheDay::create(gnote::NoteManagerBase & manager, const Glib::Date & date)
+NoteOfTheDayIndex::NoteOfTheDayIndex(gnote::NoteManagerBase & manager)
+  : m_template_note(nullptr)
+{
+  manager.for_each([this](gnote::NoteBase & note) {
+    add(note);
+  });
+
+  m_connections.push_back(manager.signal_note_added.connect(sigc::mem_fun(*this, &NoteOfTheDayIndex::on_note_added)));
+  m_connections.push_back(manager.signal_note_deleted.connect(sigc::mem_fun(*this, &NoteOfTheDayIndex::on_note_deleted)));
+  m_connections.push_back(manager.signal_note_renamed.connect(sigc::mem_fun(*this, &NoteOfTheDayIndex::on_note_renamed)));
+}
+
+NoteOfTheDayIndex::~NoteOfTheDayIndex()
+{
+  for(auto & conn : m_connections) {
+    conn.disconnect();
+  }
+}
+
+gnote::NoteBase::ORef NoteOfTheDayIndex::get_note_by_date(const Glib::Date & date) const
+{
+  auto iter = m_notes.find(date.get_julian());
+  if(iter == m_notes.end()) {
+    return gnote::NoteBase::ORef();
+  }
+  return *iter->second;
+}
+
+gnote::NoteBase::ORef NoteOfTheDayIndex::template_note() const
+{
+  if(m_template_note) {
+    return *m_template_note;
+  }
+  return gnote::NoteBase::ORef();
+}
+
+Glib::Date NoteOfTheDayIndex::note_date(const gnote::NoteBase & note)
+{
+  const auto & date_time = note.create_date();
+  return Glib::Date(
+    date_time.get_day_of_month(),
+    static_cast<Glib::Date::Month>(date_time.get_month()),
+    date_time.get_year());
+}
+
+void NoteOfTheDayIndex::add(gnote::NoteBase & note)
+{
+  if(note.get_title() == NoteOfTheDay::s_template_title) {
+    m_template_note = &note;
+  }
+  else if(NoteOfTheDay::is_note_of_the_day(note)) {
+    m_notes.emplace(note_date(note).get_julian(), &note);
+  }
+}
+
+void NoteOfTheDayIndex::remove(const gnote::NoteBase & note)
+{
+  if(m_template_note == &note) {
+    m_template_note = nullptr;
+    return;
+  }
+
+  for(auto iter = m_notes.begin(); iter != m_notes.end(); ++iter) {
+    if(iter->second == &note) {
+      m_notes.erase(iter);
+      return;
+    }
+  }
+}
+
+void NoteOfTheDayIndex::on_note_added(gnote::NoteBase & note)
+{
+  add(note);
+}
+
+void NoteOfTheDayIndex::on_note_deleted(gnote::NoteBase & note)
+{
+  remove(note);
+}
+
+void NoteOfTheDayIndex::on_note_renamed(const gnote::NoteBase & note, const Glib::ustring &)
+{
+  remove(note);
+  add(const_cast<gnote::NoteBase&>(note));
+}
+
+
+gnote::NoteBase::ORef NoteOfTheDay::create(gnote::NoteManagerBase & manager, const NoteOfTheDayIndex & index, const Glib::Date & date)
 {
   Glib::ustring title = get_title(date);
-  Glib::ustring xml = get_content(date, manager);
+  Glib::ustring xml = get_content(date, index);
 
   gnote::NoteBase::ORef notd;
   try {
@@ -56,40 +143,31 @@ gnote::NoteBase::ORef NoteOfTheDay::create(gnote::NoteManagerBase & manager, con
   return notd;
 }
 
-void NoteOfTheDay::cleanup_old(gnote::NoteManagerBase & manager)
+void NoteOfTheDay::cleanup_old(gnote::NoteManagerBase & manager, const NoteOfTheDayIndex & index)
 {
   std::vector<gnote::NoteBase::Ref> kill_list;
 
   Glib::Date date;
   date.set_time_current(); // time set to 00:00:00
 
-  manager.for_each([&kill_list, date](gnote::NoteBase & note) {
-    const Glib::ustring & title = note.get_title();
-    const auto & date_time = note.create_date();
-
-    if (true == Glib::str_has_prefix(title, s_title_prefix)
-        && s_template_title != title
-        && Glib::Date(
-             date_time.get_day_of_month(),
-             static_cast<Glib::Date::Month>(date_time.get_month()),
-             date_time.get_year()) != date
-        && !has_changed(note)) {
+  index.for_each([&kill_list, &index, date](const Glib::Date & note_date, gnote::NoteBase & note) {
+    if(note_date != date && !has_changed(note, note_date, index)) {
+      DBG_OUT("NoteOfTheDay: Deleting old unmodified '%s'", note.get_title().c_str());
       kill_list.push_back(note);
     }
   });
 
-  for(const auto & note : kill_list) {
-    DBG_OUT("NoteOfTheDay: Deleting old unmodified '%s'", note.get().get_title().c_str());
-    manager.delete_note(note);
+  if(!kill_list.empty()) {
+    manager.delete_notes(kill_list);
   }
 }
 
-Glib::ustring NoteOfTheDay::get_content(const Glib::Date & date, const gnote::NoteManagerBase & manager)
+Glib::ustring NoteOfTheDay::get_content(const Glib::Date & date, const NoteOfTheDayIndex & index)
 {
   const Glib::ustring title = get_title(date);
 
   // Attempt to load content from template
-  auto template_note = manager.find(s_template_title);
+  auto template_note = index.template_note();
 
   if(template_note) {
     Glib::ustring xml_content = template_note.value().get().xml_content();
@@ -112,23 +190,9 @@ Glib::ustring NoteOfTheDay::get_content_without_title(const Glib::ustring & cont
     return Glib::ustring();
 }
 
-gnote::NoteBase::ORef NoteOfTheDay::get_note_by_date(gnote::NoteManagerBase & manager, const Glib::Date & date)
+gnote::NoteBase::ORef NoteOfTheDay::get_note_by_date(const NoteOfTheDayIndex & index, const Glib::Date & date)
 {
-  return manager.search([date](gnote::NoteBase & note, gnote::NoteBase::ORef & ret) {
-    const Glib::ustring & title = note.get_title();
-    const auto & date_time = note.create_date();
-
-    if (true == Glib::str_has_prefix(title, s_title_prefix)
-        && s_template_title != title
-        && Glib::Date(
-             date_time.get_day_of_month(),
-             static_cast<Glib::Date::Month>(date_time.get_month()),
-             date_time.get_year()) == date) {
-      ret = note;
-      return false;
-    }
-    return true;
-  }, gnote::NoteBase::ORef());
+  return index.get_note_by_date(date);
 }
 
 Glib::ustring NoteOfTheDay::get_template_content(const Glib::ustring & title)
@@ -150,17 +214,17 @@ Glib::ustring NoteOfTheDay::get_title(const Glib::Date & date)
   return s_title_prefix + date.format_string(_("%A, %B %d %Y"));
 }
 
-bool NoteOfTheDay::has_changed(gnote::NoteBase & note)
+bool NoteOfTheDay::has_changed(gnote::NoteBase & note, const Glib::Date & date, const NoteOfTheDayIndex & index)
 {
-  const auto & date_time = note.create_date();
-  const Glib::ustring original_xml
-    = get_content(Glib::Date(
-                    date_time.get_day_of_month(),
-                    static_cast<Glib::Date::Month>(date_time.get_month()),
-                    date_time.get_year()),
-                    note.manager());
+  const Glib::ustring original_xml = get_content(date, index);
 
   return get_content_without_title(note.text_content()) != get_content_without_title(gnote::utils::XmlDecoder::decode(original_xml));
 }
 
+bool NoteOfTheDay::is_note_of_the_day(const gnote::NoteBase & note)
+{
+  const Glib::ustring & title = note.get_title();
+  return Glib::str_has_prefix(title, s_title_prefix) && s_template_title != title;
+}
+
 }
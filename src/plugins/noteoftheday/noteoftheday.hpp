@@ -21,6 +21,8 @@
 #ifndef __NOTE_OF_THE_DAY_HPP_
 #define __NOTE_OF_THE_DAY_HPP_
 
+#include <map>
+
 #include <glibmm/date.h>
 
 #include "sharp/dynamicmodule.hpp"
@@ -29,17 +31,47 @@
 
 namespace noteoftheday {
 
+// Note of the Day notes and the template keyed by date, updated from note manager signals
+class NoteOfTheDayIndex
+{
+public:
+  explicit NoteOfTheDayIndex(gnote::NoteManagerBase & manager);
+  ~NoteOfTheDayIndex();
+
+  gnote::NoteBase::ORef get_note_by_date(const Glib::Date & date) const;
+  gnote::NoteBase::ORef template_note() const;
+  template <typename F>
+  void for_each(const F & func) const
+    {
+      for(const auto & entry : m_notes) {
+        func(Glib::Date(entry.first), *entry.second);
+      }
+    }
+private:
+  static Glib::Date note_date(const gnote::NoteBase & note);
+  void add(gnote::NoteBase & note);
+  void remove(const gnote::NoteBase & note);
+  void on_note_added(gnote::NoteBase & note);
+  void on_note_deleted(gnote::NoteBase & note);
+  void on_note_renamed(const gnote::NoteBase & note, const Glib::ustring & old_title);
+
+  std::multimap<guint32, gnote::NoteBase*> m_notes;
+  gnote::NoteBase *m_template_note;
+  std::vector<sigc::connection> m_connections;
+};
+
 class NoteOfTheDay
 {
 public:
 
-  static gnote::NoteBase::ORef create(gnote::NoteManagerBase & manager, const Glib::Date & date);
-  static void cleanup_old(gnote::NoteManagerBase & manager);
-  static Glib::ustring get_content(const Glib::Date & date, const gnote::NoteManagerBase & manager);
-  static gnote::NoteBase::ORef get_note_by_date(gnote::NoteManagerBase & manager, const Glib::Date & date);
+  static gnote::NoteBase::ORef create(gnote::NoteManagerBase & manager, const NoteOfTheDayIndex & index, const Glib::Date & date);
+  static void cleanup_old(gnote::NoteManagerBase & manager, const NoteOfTheDayIndex & index);
+  static Glib::ustring get_content(const Glib::Date & date, const NoteOfTheDayIndex & index);
+  static gnote::NoteBase::ORef get_note_by_date(const NoteOfTheDayIndex & index, const Glib::Date & date);
   static Glib::ustring get_template_content(const Glib::ustring & title);
   static Glib::ustring get_title(const Glib::Date & date);
-  static bool has_changed(gnote::NoteBase & note);
+  static bool has_changed(gnote::NoteBase & note, const Glib::Date & date, const NoteOfTheDayIndex & index);
+  static bool is_note_of_the_day(const gnote::NoteBase & note);
 
   static const Glib::ustring s_template_title;
 
@@ -54,16 +54,24 @@ void NoteOfTheDayApplicationAddin::check_new_day() const
   Glib::Date date;
   date.set_time_current();
 
-  if(!NoteOfTheDay::get_note_by_date(note_manager(), date)) {
-    NoteOfTheDay::cleanup_old(note_manager());
+  if(!m_index) {
+    return;
+  }
+
+  if(!NoteOfTheDay::get_note_by_date(*m_index, date)) {
+    NoteOfTheDay::cleanup_old(note_manager(), *m_index);
 
     // Create a new NotD if the day has changed
-    NoteOfTheDay::create(note_manager(), date);
+    NoteOfTheDay::create(note_manager(), *m_index, date);
   }
 }
 
 void NoteOfTheDayApplicationAddin::initialize()
 {
+  if(!m_index) {
+    m_index = std::make_unique<NoteOfTheDayIndex>(note_manager());
+  }
+
   if (!m_timeout) {
     m_timeout
       = Glib::signal_timeout().connect_seconds(
@@ -89,6 +97,7 @@ void NoteOfTheDayApplicationAddin::shutdown()
   if (m_timeout)
     m_timeout.disconnect();
 
+  m_index.reset();
   m_initialized = false;
 }
 
@@ -21,6 +21,8 @@
 #ifndef __NOTE_OF_THE_DAY_APPLICATION_ADDIN_HPP_
 #define __NOTE_OF_THE_DAY_APPLICATION_ADDIN_HPP_
 
+#include <memory>
+
 #include <sigc++/sigc++.h>
 
 #include "sharp/dynamicmodule.hpp"
@@ -34,6 +36,8 @@ class NoteManager;
 
 namespace noteoftheday {
 
+class NoteOfTheDayIndex;
+
 class NoteOfTheDayModule
   : public sharp::DynamicModule
 {
@@ -64,6 +68,7 @@ private:
 
   bool m_initialized;
   sigc::connection m_timeout;
+  std::unique_ptr<NoteOfTheDayIndex> m_index;
 };
 
 }
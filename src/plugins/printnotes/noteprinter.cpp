@@ -0,0 +1,429 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <atomic>
+#include <algorithm>
+#include <mutex>
+
+#include <cairomm/surface.h>
+#include <glibmm/i18n.h>
+#include <pango/pangocairo.h>
+
+#include "debug.hpp"
+#include "noteprinter.hpp"
+#include "notetag.hpp"
+#include "threadpool.hpp"
+#include "tracing.hpp"
+#include "utils.hpp"
+#include "sharp/datetime.hpp"
+#include "sharp/exception.hpp"
+
+namespace printnotes {
+
+namespace {
+
+// A4 in points, the PDF surface unit
+const double PDF_PAGE_WIDTH = 595.0;
+const double PDF_PAGE_HEIGHT = 842.0;
+const double PDF_DPI = 72.0;
+// the PDF page is the full sheet, keep the footer off the edge
+const double PDF_MARGIN_BOTTOM_CM = 1.0;
+
+void get_segment_attributes(std::vector<Pango::Attribute> & attributes, PrintParagraph & paragraph, double screen_dpi_x,
+                            Gtk::TextIter & position, const Gtk::TextIter & limit)
+{
+  auto tags = position.get_tags();
+  position.forward_to_tag_toggle(Glib::RefPtr<Gtk::TextTag>(NULL));
+  if(position.compare(limit) > 0) {
+    position = limit;
+  }
+
+  for(auto tag : tags) {
+    if(tag->property_paragraph_background_set()) {
+      Gdk::RGBA color = tag->property_paragraph_background_rgba();
+      attributes.push_back(Pango::Attribute::create_attr_background(
+                             color.get_red_u(), color.get_green_u(), color.get_blue_u()));
+    }
+    if(tag->property_foreground_set()) {
+      Gdk::RGBA color = tag->property_foreground_rgba();
+      attributes.push_back(Pango::Attribute::create_attr_foreground(
+                             color.get_red_u(), color.get_green_u(), color.get_blue_u()));
+    }
+    if(tag->property_indent_set()) {
+      paragraph.layout_indent = tag->property_indent();
+    }
+    if(tag->property_left_margin_set()) {
+      paragraph.margin = tag->property_left_margin() / screen_dpi_x;
+    }
+    if(tag->property_right_margin_set()) {
+      paragraph.margin = tag->property_right_margin() / screen_dpi_x;
+    }
+    attributes.push_back(Pango::Attribute::create_attr_font_desc(tag->property_font_desc()));
+    if(tag->property_family_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_family(tag->property_family()));
+    }
+    if(tag->property_size_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_size(tag->property_size()));
+    }
+    if(tag->property_style_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_style(tag->property_style()));
+    }
+    if(tag->property_underline_set() && tag->property_underline() != Pango::Underline::ERROR) {
+      attributes.push_back(Pango::Attribute::create_attr_underline(tag->property_underline()));
+    }
+    if(tag->property_weight_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_weight(Pango::Weight(tag->property_weight().get_value())));
+    }
+    if(tag->property_strikethrough_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_strikethrough(tag->property_strikethrough()));
+    }
+    if(tag->property_rise_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_rise(tag->property_rise()));
+    }
+    if(tag->property_scale_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_scale(tag->property_scale()));
+    }
+    if(tag->property_stretch_set()) {
+      attributes.push_back(Pango::Attribute::create_attr_stretch(tag->property_stretch()));
+    }
+  }
+}
+
+}
+
+
+std::vector<PrintParagraph> get_print_paragraphs(const gnote::NoteBuffer::Ptr & buffer, double screen_dpi_x)
+{
+  std::vector<PrintParagraph> paragraphs;
+  Gtk::TextIter position;
+  Gtk::TextIter end_iter;
+  buffer->get_bounds(position, end_iter);
+
+  std::vector<Pango::Attribute> attributes;
+  bool done = position.compare(end_iter) >= 0;
+  while(!done) {
+    Gtk::TextIter line_end = position;
+    if(!line_end.ends_line()) {
+      line_end.forward_to_line_end();
+    }
+
+    PrintParagraph paragraph;
+    int start_index = position.get_line_index();
+    Gtk::TextIter segm_start = position;
+    while(segm_start.compare(line_end) < 0) {
+      Gtk::TextIter segm_end = segm_start;
+      attributes.clear();
+      get_segment_attributes(attributes, paragraph, screen_dpi_x, segm_end, line_end);
+
+      guint si = (guint) (segm_start.get_line_index() - start_index);
+      guint ei = (guint) (segm_end.get_line_index() - start_index);
+      for(auto & a : attributes) {
+        a.set_start_index(si);
+        a.set_end_index(ei);
+        paragraph.attributes.insert(a);
+      }
+      segm_start = segm_end;
+    }
+
+    gnote::DepthNoteTag::Ptr depth = buffer->find_depth_tag(position);
+    if(depth) {
+      paragraph.depth = depth->get_depth();
+    }
+    paragraph.text = buffer->get_slice(position, line_end, false);
+    paragraphs.push_back(std::move(paragraph));
+
+    position.forward_line();
+    done = position.compare(end_iter) >= 0;
+  }
+
+  return paragraphs;
+}
+
+
+NotePrinter::NotePrinter(std::vector<PrintParagraph> && paragraphs, const Pango::FontDescription & font)
+  : m_paragraphs(std::move(paragraphs))
+  , m_font(font)
+  , m_width(0)
+  , m_height(0)
+  , m_dpi_x(0)
+  , m_margin_top(0)
+  , m_margin_left(0)
+  , m_margin_right(0)
+  , m_margin_bottom(0)
+{
+}
+
+
+int NotePrinter::paginate(const Glib::RefPtr<Pango::Context> & context, double width, double height, double dpi_x, double dpi_y,
+                          double margin_bottom_cm)
+{
+  m_context = context;
+  m_width = width;
+  m_height = height;
+  m_dpi_x = dpi_x;
+  m_margin_top = cm_to_pixel(1.5, dpi_y);
+  m_margin_left = cm_to_pixel(1, dpi_x);
+  m_margin_right = cm_to_pixel(1, dpi_x);
+  m_margin_bottom = cm_to_pixel(margin_bottom_cm, dpi_y);
+
+  m_timestamp_footer = create_layout_for_timestamp();
+  int footer_height;
+  {
+    Pango::Rectangle ink_rect;
+    Pango::Rectangle logical_rect;
+    m_timestamp_footer->get_extents(ink_rect, logical_rect);
+    footer_height = pango_units_to_double(ink_rect.get_height()) + cm_to_pixel(0.5, dpi_y);
+  }
+  double max_height = pango_units_from_double(height - m_margin_top - m_margin_bottom - footer_height);
+
+  DBG_OUT("margins = %d %d %d %d", m_margin_top, m_margin_left, m_margin_right, m_margin_bottom);
+
+  m_layouts.clear();
+  m_layouts.reserve(m_paragraphs.size());
+  m_page_breaks.clear();
+
+  double page_height = 0;
+  for(unsigned paragraph_number = 0; paragraph_number < m_paragraphs.size(); ++paragraph_number) {
+    m_layouts.push_back(create_layout_for_paragraph(m_paragraphs[paragraph_number]));
+    auto & layout = m_layouts.back().layout;
+
+    Pango::Rectangle ink_rect;
+    Pango::Rectangle logical_rect;
+    int line_count = layout->get_line_count();
+    for(int line_in_paragraph = 0; line_in_paragraph < line_count; line_in_paragraph++) {
+      layout->get_line(line_in_paragraph)->get_extents(ink_rect, logical_rect);
+
+      if((page_height + logical_rect.get_height()) >= max_height) {
+        m_page_breaks.push_back(PageBreak(paragraph_number, line_in_paragraph));
+        page_height = 0;
+      }
+
+      page_height += logical_rect.get_height();
+    }
+  }
+
+  return page_count();
+}
+
+
+NotePrinter::ParagraphLayout NotePrinter::create_layout_for_paragraph(const PrintParagraph & paragraph)
+{
+  ParagraphLayout result;
+  result.layout = Pango::Layout::create(m_context);
+  result.layout->set_font_description(m_font);
+  result.layout->set_attributes(paragraph.attributes);
+  result.layout->set_indent(paragraph.layout_indent);
+  result.indentation = (int) (paragraph.margin * m_dpi_x) + ((int) (m_dpi_x / 3)) * paragraph.depth;
+  result.layout->set_width(pango_units_from_double((int) m_width - m_margin_left - m_margin_right - result.indentation));
+  result.layout->set_wrap(Pango::WrapMode::WORD_CHAR);
+  result.layout->set_text(paragraph.text);
+  return result;
+}
+
+
+Pango::FontDescription NotePrinter::footer_font() const
+{
+  Pango::FontDescription font_desc = m_font;
+  font_desc.set_style(Pango::Style::NORMAL);
+  font_desc.set_weight(Pango::Weight::LIGHT);
+  return font_desc;
+}
+
+
+Glib::RefPtr<Pango::Layout> NotePrinter::create_layout_for_pagenumbers(int page_number, int total_pages)
+{
+  Glib::RefPtr<Pango::Layout> layout = Pango::Layout::create(m_context);
+  layout->set_font_description(footer_font());
+  layout->set_width(pango_units_from_double((int) m_width));
+
+  // %1 is the page number, %2 is the total number of pages
+  Glib::ustring footer_left = Glib::ustring::compose(_("Page %1 of %2"), page_number, total_pages);
+  layout->set_alignment(Pango::Alignment::LEFT);
+  layout->set_text(footer_left);
+
+  return layout;
+}
+
+
+Glib::RefPtr<Pango::Layout> NotePrinter::create_layout_for_timestamp()
+{
+  Glib::ustring timestamp = sharp::date_time_to_string(Glib::DateTime::create_now_local(), "%c");
+
+  Glib::RefPtr<Pango::Layout> layout = Pango::Layout::create(m_context);
+  layout->set_font_description(footer_font());
+  layout->set_width(pango_units_from_double((int) m_width));
+
+  layout->set_alignment(Pango::Alignment::RIGHT);
+  layout->set_text(timestamp);
+
+  return layout;
+}
+
+
+void NotePrinter::draw_page(const Cairo::RefPtr<Cairo::Context> & cr, int page_nr)
+{
+  cr->move_to(m_margin_left, m_margin_top);
+
+  PageBreak start;
+  if(page_nr != 0) {
+    start = m_page_breaks[page_nr - 1];
+  }
+
+  PageBreak end(-1, -1);
+  if((int) m_page_breaks.size() > page_nr) {
+    end = m_page_breaks[page_nr];
+  }
+
+  bool done = false;
+  for(int paragraph_number = start.get_paragraph(); !done && paragraph_number < (int) m_layouts.size(); ++paragraph_number) {
+    auto & layout = m_layouts[paragraph_number].layout;
+    int indentation = m_layouts[paragraph_number].indentation;
+    int line_count = layout->get_line_count();
+    for(int line_number = 0; line_number < line_count; line_number++) {
+      // Skip the lines up to the starting line in the
+      // first paragraph on this page
+      if((paragraph_number == start.get_paragraph()) && (line_number < start.get_line())) {
+        continue;
+      }
+      // Break as soon as we hit the end line
+      if((paragraph_number == end.get_paragraph()) && (line_number == end.get_line())) {
+        done = true;
+        break;
+      }
+
+      Glib::RefPtr<Pango::LayoutLine> line = layout->get_line(line_number);
+
+      Pango::Rectangle ink_rect;
+      Pango::Rectangle logical_rect;
+      line->get_extents(ink_rect, logical_rect);
+
+      double curX, curY;
+      cr->get_current_point(curX, curY);
+      double x = m_margin_left + indentation;
+      double y = curY + (int) pango_units_to_double(logical_rect.get_height());
+      cr->move_to(x, curY);
+      pango_cairo_show_layout_line(cr->cobj(), line->gobj());
+      cr->move_to(x, y);
+    }
+  }
+
+  draw_footer(cr, page_nr);
+}
+
+
+void NotePrinter::draw_footer(const Cairo::RefPtr<Cairo::Context> & cr, int page_nr)
+{
+  int total_height = m_height;
+  int total_width = m_width;
+  int footer_margin = cm_to_pixel(0.5, m_dpi_x);
+
+  Glib::RefPtr<Pango::Layout> pages_footer = create_layout_for_pagenumbers(page_nr + 1, page_count());
+  Pango::Rectangle ink_footer_rect;
+  Pango::Rectangle logical_footer_rect;
+  pages_footer->get_extents(ink_footer_rect, logical_footer_rect);
+
+  double footer_anchor_x = footer_margin;
+  double footer_anchor_y = total_height - m_margin_bottom;
+  int footer_height = pango_units_to_double(logical_footer_rect.get_height());
+
+  cr->move_to(total_width - pango_units_to_double(logical_footer_rect.get_width()) - footer_margin, footer_anchor_y);
+  pango_cairo_show_layout_line(cr->cobj(), (pages_footer->get_line(0))->gobj());
+
+  cr->move_to(footer_anchor_x, footer_anchor_y);
+  pango_cairo_show_layout_line(cr->cobj(), (m_timestamp_footer->get_line(0))->gobj());
+
+  cr->move_to(footer_margin, total_height - m_margin_bottom - footer_height);
+  cr->line_to(total_width - footer_margin, total_height - m_margin_bottom - footer_height);
+  cr->stroke();
+}
+
+
+void print_to_pdf(PdfJob & job)
+{
+  TRACE_SPAN("export_pdf");
+  try {
+    auto surface = Cairo::PdfSurface::create(job.file_name, PDF_PAGE_WIDTH, PDF_PAGE_HEIGHT);
+    auto cr = Cairo::Context::create(surface);
+
+    // Pango font maps are not thread safe, use a private one per job
+    PangoFontMap *font_map = pango_cairo_font_map_new();
+    Glib::RefPtr<Pango::Context> context = Glib::wrap(pango_font_map_create_context(font_map));
+    g_object_unref(font_map);
+    pango_cairo_context_set_resolution(context->gobj(), PDF_DPI);
+    pango_cairo_update_context(cr->cobj(), context->gobj());
+
+    NotePrinter printer(std::move(job.paragraphs), job.font);
+    int pages = printer.paginate(context, PDF_PAGE_WIDTH, PDF_PAGE_HEIGHT, PDF_DPI, PDF_DPI, PDF_MARGIN_BOTTOM_CM);
+    for(int page = 0; page < pages; ++page) {
+      printer.draw_page(cr, page);
+      cr->show_page();
+    }
+    surface->finish();
+  }
+  catch(std::exception & e) {
+    throw sharp::Exception(Glib::ustring::compose("%1: %2", job.file_name, e.what()));
+  }
+}
+
+
+void print_to_pdf_async(std::vector<PdfJob> && jobs, std::function<void(std::vector<Glib::ustring>)> && on_done)
+{
+  struct State
+  {
+    std::vector<PdfJob> jobs;
+    std::function<void(std::vector<Glib::ustring>)> on_done;
+    std::atomic<unsigned> remaining{0};
+    std::mutex lock;
+    std::vector<Glib::ustring> errors;
+  };
+
+  auto state = std::make_shared<State>();
+  state->jobs = std::move(jobs);
+  state->on_done = std::move(on_done);
+  state->remaining = state->jobs.size();
+  if(state->jobs.empty()) {
+    gnote::utils::main_context_invoke([state]() {
+      state->on_done(std::move(state->errors));
+    });
+    return;
+  }
+
+  auto & pool = gnote::ThreadPool::get_default();
+  for(unsigned job = 0; job < state->jobs.size(); ++job) {
+    pool.submit([state, job]() {
+      try {
+        print_to_pdf(state->jobs[job]);
+      }
+      catch(sharp::Exception & e) {
+        ERR_OUT("Failed to export note to PDF: %s", e.what());
+        std::lock_guard<std::mutex> guard(state->lock);
+        state->errors.push_back(e.what());
+      }
+      if(--state->remaining == 0) {
+        gnote::utils::main_context_invoke([state]() {
+          state->on_done(std::move(state->errors));
+        });
+      }
+    }, gnote::ThreadPool::Priority::LOW);
+  }
+}
+
+}
+
@@ -0,0 +1,148 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __PRINTNOTES_NOTEPRINTER_HPP_
+#define __PRINTNOTES_NOTEPRINTER_HPP_
+
+#include <functional>
+#include <vector>
+
+#include <cairomm/context.h>
+#include <pangomm/attrlist.h>
+#include <pangomm/layout.h>
+
+#include "notebuffer.hpp"
+
+namespace printnotes {
+
+
+class PageBreak
+{
+public:
+  PageBreak(int paragraph, int line)
+    : m_break_paragraph(paragraph)
+    , m_break_line(line)
+    {
+    }
+  PageBreak()
+    : m_break_paragraph(0)
+    , m_break_line(0)
+    {
+    }
+  int get_paragraph() const
+    {
+      return m_break_paragraph;
+    }
+  int get_line() const
+    {
+      return m_break_line;
+    }
+private:
+  int m_break_paragraph;
+  int m_break_line;
+};
+
+
+// One line of the note buffer with its formatting, no longer tied to the buffer,
+// so it can be laid out on any thread.
+struct PrintParagraph
+{
+  Glib::ustring text;
+  Pango::AttrList attributes;
+  int layout_indent = 0;
+  // left or right margin relative to screen resolution, multiplied by target dpi
+  double margin = 0;
+  int depth = 0;
+};
+
+std::vector<PrintParagraph> get_print_paragraphs(const gnote::NoteBuffer::Ptr & buffer, double screen_dpi_x);
+
+
+// Lays out paragraphs once, splits them into pages and draws the pages
+// reusing the same layouts.
+class NotePrinter
+{
+public:
+  NotePrinter(std::vector<PrintParagraph> && paragraphs, const Pango::FontDescription & font);
+
+  // margin_bottom_cm is for surfaces without unprintable area, like PDF
+  int paginate(const Glib::RefPtr<Pango::Context> & context, double width, double height, double dpi_x, double dpi_y,
+               double margin_bottom_cm = 0);
+  int page_count() const
+    {
+      return m_page_breaks.size() + 1;
+    }
+  void draw_page(const Cairo::RefPtr<Cairo::Context> & cr, int page_nr);
+
+  static int cm_to_pixel(double cm, double dpi)
+    {
+      return (int) (cm * dpi / 2.54);
+    }
+  static int inch_to_pixel(double inch, double dpi)
+    {
+      return (int) (inch * dpi);
+    }
+private:
+  struct ParagraphLayout
+  {
+    Glib::RefPtr<Pango::Layout> layout;
+    int indentation;
+  };
+
+  ParagraphLayout create_layout_for_paragraph(const PrintParagraph & paragraph);
+  Glib::RefPtr<Pango::Layout> create_layout_for_pagenumbers(int page_number, int total_pages);
+  Glib::RefPtr<Pango::Layout> create_layout_for_timestamp();
+  Pango::FontDescription footer_font() const;
+  void draw_footer(const Cairo::RefPtr<Cairo::Context> & cr, int page_nr);
+
+  std::vector<PrintParagraph> m_paragraphs;
+  Pango::FontDescription m_font;
+  Glib::RefPtr<Pango::Context> m_context;
+  std::vector<ParagraphLayout> m_layouts;
+  std::vector<PageBreak> m_page_breaks;
+  Glib::RefPtr<Pango::Layout> m_timestamp_footer;
+  double m_width;
+  double m_height;
+  double m_dpi_x;
+  int m_margin_top;
+  int m_margin_left;
+  int m_margin_right;
+  int m_margin_bottom;
+};
+
+
+struct PdfJob
+{
+  Glib::ustring file_name;
+  std::vector<PrintParagraph> paragraphs;
+  Pango::FontDescription font;
+};
+
+// Render a note to a PDF file without a print dialog, safe to call from a worker thread.
+// Throws sharp::Exception on failure.
+void print_to_pdf(PdfJob & job);
+
+// Render notes to PDF on worker threads, on_done receives errors and is invoked in main context.
+void print_to_pdf_async(std::vector<PdfJob> && jobs, std::function<void(std::vector<Glib::ustring>)> && on_done);
+
+}
+
+#endif
+
@@ -26,12 +26,14 @@
 #ifndef __PRINTNOTES_NOTEADDIN_HPP_
 #define __PRINTNOTES_NOTEADDIN_HPP_
 
+#include <memory>
 #include <vector>
 
 #include <pangomm/layout.h>
 
 #include "sharp/dynamicmodule.hpp"
 #include "noteaddin.hpp"
+#include "noteprinter.hpp"
 
 namespace printnotes {
 
@@ -46,33 +48,6 @@ public:
 
 DECLARE_MODULE(PrintNotesModule);
 
-class PageBreak
-{
-public:
-  PageBreak(int paragraph, int line)
-    : m_break_paragraph(paragraph)
-    , m_break_line(line)
-    {
-    }
-  PageBreak()
-    : m_break_paragraph(0)
-    , m_break_line(0)
-    {
-    }
-  int get_paragraph() const
-    {
-      return m_break_paragraph;
-    }
-  int get_line() const
-    {
-      return m_break_line;
-    }
-private:
-  int m_break_paragraph;
-  int m_break_line;
-};
-
-
 class PrintNotesNoteAddin
   : public gnote::NoteAddin
 {
@@ -86,42 +61,17 @@ public:
   virtual void on_note_opened() override;
   virtual std::vector<gnote::PopoverWidget> get_actions_popover_widgets() const override;
 
-  static int cm_to_pixel(double cm, double dpi)
-		{
-			return (int) (cm * dpi / 2.54);
-		}
-  static int inch_to_pixel(double inch, double dpi)
-		{
-			return (int) (inch * dpi);
-		}
-
 private:
-  std::vector<Pango::Attribute> get_paragraph_attributes(const Glib::RefPtr<Pango::Layout> & layout,
-                                double dpiX, int & indentation,
-                                Gtk::TextIter & position, 
-                                const Gtk::TextIter & limit);
-  Glib::RefPtr<Pango::Layout> create_layout_for_paragraph(const Glib::RefPtr<Gtk::PrintContext> & context, 
-                                                          Gtk::TextIter p_start,
-                                                          Gtk::TextIter p_end,
-                                                          int & indentation);
-  Glib::RefPtr<Pango::Layout> create_layout_for_pagenumbers(const Glib::RefPtr<Gtk::PrintContext> & context, int page_number, int total_pages);
-  Glib::RefPtr<Pango::Layout> create_layout_for_timestamp(const Glib::RefPtr<Gtk::PrintContext> & context);
-  int compute_footer_height(const Glib::RefPtr<Gtk::PrintContext> & context);
+  double get_screen_dpi_x();
   void on_begin_print(const Glib::RefPtr<Gtk::PrintContext>&);
-  void print_footer(const Glib::RefPtr<Gtk::PrintContext>&, guint);
-
   void on_draw_page(const Glib::RefPtr<Gtk::PrintContext>&, guint);
   void on_end_print(const Glib::RefPtr<Gtk::PrintContext>&);
 /////
   void print_button_clicked(const Glib::VariantBase&);
+  void export_pdf_clicked(const Glib::VariantBase&);
 
-  int                  m_margin_top;
-  int                  m_margin_left;
-  int                  m_margin_right;
-  int                  m_margin_bottom;
-  std::vector<PageBreak> m_page_breaks;
+  std::unique_ptr<NotePrinter> m_printer;
   Glib::RefPtr<Gtk::PrintOperation> m_print_op;
-  Glib::RefPtr<Pango::Layout> m_timestamp_footer;
 };
 
 }
@@ -18,6 +18,8 @@
  */
 
 
+#include <algorithm>
+
 #include <giomm/liststore.h>
 #include <glibmm/i18n.h>
 #include <gtkmm/signallistitemfactory.h>
@@ -26,6 +28,7 @@
 #include "debug.hpp"
 #include "ignote.hpp"
 #include "itagmanager.hpp"
+#include "memoryusage.hpp"
 #include "statisticswidget.hpp"
 #include "utils.hpp"
 #include "base/hash.hpp"
@@ -74,6 +77,7 @@ private:
       set_model(m_model);
       nm.signal_note_added.connect(sigc::mem_fun(*this, &StatisticsModel::on_note_list_changed));
       nm.signal_note_deleted.connect(sigc::mem_fun(*this, &StatisticsModel::on_note_list_changed));
+      nm.signal_bulk_mutation_ended.connect(sigc::mem_fun(*this, &StatisticsModel::update));
       g.notebook_manager().signal_note_added_to_notebook
         .connect(sigc::mem_fun(*this, &StatisticsModel::on_notebook_note_list_changed));
       g.notebook_manager().signal_note_removed_from_notebook
@@ -121,17 +125,50 @@ private:
         m_model->append(StatisticsRecord::create({"\t" + nb.first.get().get_name(), Glib::ustring::compose(fmt, nb.second)}));
       }
 
+      build_memory_stats();
+
       DBG_OUT("Statistics updated");
     }
 
+  // estimates, refreshed whenever statistics are rebuilt
+  void build_memory_stats()
+    {
+      std::int64_t total = 0;
+      std::vector<StatisticsRow> rows;
+      for(int i = 0; i < static_cast<int>(gnote::memory::Category::COUNT); ++i) {
+        auto category = static_cast<gnote::memory::Category>(i);
+        std::int64_t bytes = gnote::memory::usage(category);
+        total += bytes;
+        rows.push_back({Glib::ustring("\t") + gnote::memory::category_label(category), format_size(bytes)});
+      }
+
+      m_model->append(StatisticsRecord::create({_("Memory Usage"), format_size(total)}));
+      for(const auto & row : rows) {
+        m_model->append(StatisticsRecord::create(row));
+      }
+    }
+
+  static Glib::ustring format_size(std::int64_t bytes)
+    {
+      char *size = g_format_size(std::max<std::int64_t>(bytes, 0));
+      Glib::ustring result(size);
+      g_free(size);
+      return result;
+    }
+
   void on_note_list_changed(gnote::NoteBase &)
     {
-      update();
+      // rebuilt once, when bulk mutation ends
+      if(!m_note_manager.in_bulk_mutation()) {
+        update();
+      }
     }
 
   void on_notebook_note_list_changed(const gnote::Note &, const gnote::notebooks::Notebook &)
     {
-      update();
+      if(!m_note_manager.in_bulk_mutation()) {
+        update();
+      }
     }
 
   gnote::IGnote & m_gnote;
@@ -53,6 +53,7 @@ enum NoteActionOrder {
   EXPORT_TO_GTG_ORDER = 200,
   INSERT_TIMESTAMP_ORDER = 300,
   PRINT_ORDER = 400,
+  PRINT_TO_PDF_ORDER = 450,
   REPLACE_TITLE_ORDER = 500,
 };
 
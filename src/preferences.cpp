@@ -21,6 +21,7 @@
 
 
 #include "preferences.hpp"
+#include "sharp/string.hpp"
 
 #define SETUP_CACHED_KEY(schema, key, KEY, type) \
   do { \
@@ -93,6 +94,8 @@ const Glib::ustring SEARCH_WINDOW_HEIGHT = "search-window-height";
 const Glib::ustring SEARCH_WINDOW_SPLITTER_POS = "search-window-splitter-pos";
 const Glib::ustring SEARCH_SORTING = "search-sorting";
 const Glib::ustring USE_CLIENT_SIDE_DECORATIONS = "use-client-side-decorations";
+const Glib::ustring DBUS_PER_NOTE_SIGNALS = "dbus-per-note-signals";
+const Glib::ustring DBUS_NOTES_CHANGED_INTERVAL = "dbus-notes-changed-interval";
 
 const Glib::ustring DESKTOP_GNOME_CLOCK_FORMAT = "clock-format";
 const Glib::ustring DESKTOP_GNOME_FONT = "document-font-name";
@@ -126,6 +129,14 @@ namespace gnote {
     SETUP_CACHED_KEY(m_schema_gnote, enable_custom_font, ENABLE_CUSTOM_FONT, boolean);
     SETUP_CACHED_KEY(m_schema_gnote, note_rename_behavior, NOTE_RENAME_BEHAVIOR, int);
     SETUP_CACHED_KEY(m_schema_gnote, custom_font_face, CUSTOM_FONT_FACE, string);
+    SETUP_CACHED_KEY(m_schema_gnote, dbus_per_note_signals, DBUS_PER_NOTE_SIGNALS, boolean);
+    SETUP_CACHED_KEY(m_schema_gnote, dbus_notes_changed_interval, DBUS_NOTES_CHANGED_INTERVAL, int);
+    m_schema_gnote->signal_changed(MENU_PINNED_NOTES).connect([this](const Glib::ustring &) {
+      if(!m_writing_pinned_notes) {
+        load_pinned_notes();
+      }
+    });
+    load_pinned_notes();
 
     SETUP_CACHED_KEY(m_schema_gnome_interface, desktop_gnome_clock_format, DESKTOP_GNOME_CLOCK_FORMAT, string);
 
@@ -149,6 +160,8 @@ namespace gnote {
   DEFINE_GETTER_SETTER_INT(m_schema_gnote, search_window_splitter_pos, SEARCH_WINDOW_SPLITTER_POS)
   DEFINE_GETTER_SETTER_STRING(m_schema_gnote, search_sorting, SEARCH_SORTING)
   DEFINE_GETTER_SETTER_STRING(m_schema_gnote, use_client_side_decorations, USE_CLIENT_SIDE_DECORATIONS)
+  DEFINE_CACHING_SETTER_BOOL(m_schema_gnote, dbus_per_note_signals, DBUS_PER_NOTE_SIGNALS)
+  DEFINE_CACHING_SETTER_INT(m_schema_gnote, dbus_notes_changed_interval, DBUS_NOTES_CHANGED_INTERVAL)
 
   DEFINE_GETTER_STRING(m_schema_sync, sync_client_id, SYNC_CLIENT_ID)
   DEFINE_GETTER_SETTER_STRING(m_schema_sync, sync_local_path, SYNC_LOCAL_PATH)
@@ -161,5 +174,41 @@ namespace gnote {
   DEFINE_GETTER_SETTER_STRING(m_schema_sync_wdfs, sync_fuse_wdfs_url, SYNC_FUSE_WDFS_URL)
   DEFINE_GETTER_SETTER_STRING(m_schema_sync_wdfs, sync_fuse_wdfs_username, SYNC_FUSE_WDFS_USERNAME)
 
+
+  void Preferences::load_pinned_notes()
+  {
+    m_pinned_notes.clear();
+    std::vector<Glib::ustring> uris;
+    sharp::string_split(uris, menu_pinned_notes(), " \t\n");
+    for(auto & uri : uris) {
+      if(!uri.empty()) {
+        m_pinned_notes.insert(std::move(uri));
+      }
+    }
+  }
+
+
+  bool Preferences::set_note_pinned(const Glib::ustring & uri, bool pinned)
+  {
+    if(pinned) {
+      if(!m_pinned_notes.insert(uri).second) {
+        return false;
+      }
+    }
+    else if(m_pinned_notes.erase(uri) == 0) {
+      return false;
+    }
+
+    Glib::ustring value;
+    for(auto & pinned_uri : m_pinned_notes) {
+      value += pinned_uri;
+      value += " ";
+    }
+    m_writing_pinned_notes = true;
+    menu_pinned_notes(value);
+    m_writing_pinned_notes = false;
+    return true;
+  }
+
 }
 
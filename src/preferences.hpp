@@ -25,8 +25,11 @@
 #define __PREFERENCES_HPP_
 
 #include <map>
+#include <unordered_set>
 #include <giomm/settings.h>
 
+#include "base/hash.hpp"
+
 
 #define GNOTE_PREFERENCES_SETTING(key, rettype, paramtype) \
   rettype key() const; \
@@ -68,12 +71,21 @@ namespace gnote {
     GNOTE_PREFERENCES_SETTING_STRING(start_note_uri)
     GNOTE_PREFERENCES_CACHING_SETTING(custom_font_face, const Glib::ustring &)
     GNOTE_PREFERENCES_SETTING_STRING(menu_pinned_notes)
+    // cached set of URIs from menu_pinned_notes
+    bool is_note_pinned(const Glib::ustring & uri) const
+      {
+        return m_pinned_notes.find(uri) != m_pinned_notes.end();
+      }
+    // returns false if nothing changed
+    bool set_note_pinned(const Glib::ustring & uri, bool pinned);
     GNOTE_PREFERENCES_SETTING_BOOL(main_window_maximized)
     GNOTE_PREFERENCES_SETTING_INT(search_window_width)
     GNOTE_PREFERENCES_SETTING_INT(search_window_height)
     GNOTE_PREFERENCES_SETTING_INT(search_window_splitter_pos)
     GNOTE_PREFERENCES_SETTING_STRING(search_sorting)
     GNOTE_PREFERENCES_SETTING_STRING(use_client_side_decorations)
+    GNOTE_PREFERENCES_CACHING_SETTING(dbus_per_note_signals, bool)
+    GNOTE_PREFERENCES_CACHING_SETTING(dbus_notes_changed_interval, int)
 
     GNOTE_PREFERENCES_CACHING_SETTING_RO(desktop_gnome_clock_format, const Glib::ustring &)
 
@@ -90,6 +102,7 @@ namespace gnote {
     GNOTE_PREFERENCES_SETTING_STRING(sync_fuse_wdfs_username)
   private:
     Preferences(const Preferences &) = delete;
+    void load_pinned_notes();
 
     Glib::RefPtr<Gio::Settings> m_schema_gnote;
     Glib::RefPtr<Gio::Settings> m_schema_gnome_interface;
@@ -103,8 +116,13 @@ namespace gnote {
 
     Glib::ustring m_sync_selected_service_addin;
 
+    std::unordered_set<Glib::ustring, Hash<Glib::ustring>> m_pinned_notes;
+    // set while pinned notes are written, so that own change is not parsed again
+    bool m_writing_pinned_notes = false;
+
     int m_note_rename_behavior;
     int m_sync_autosync_timeout;
+    int m_dbus_notes_changed_interval;
 
     bool m_enable_spellchecking;
     bool m_enable_auto_links;
@@ -112,6 +130,7 @@ namespace gnote {
     bool m_enable_wikiwords;
     bool m_enable_custom_font;
     bool m_open_notes_in_new_window;
+    bool m_dbus_per_note_signals;
   };
 
 
@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011,2013-2014,2017,2019,2023 Aurimas Cernius
  * Copyright (C) 2009 Hubert Figuiere
  *
@@ -21,9 +22,12 @@
 
 
 
+#include <algorithm>
+
 #include "sharp/string.hpp"
 #include "notemanagerbase.hpp"
 #include "search.hpp"
+#include "tracing.hpp"
 #include "utils.hpp"
 
 namespace gnote {
@@ -38,6 +42,18 @@ namespace gnote {
   Search::Results Search::search_notes(const Glib::ustring & query, bool case_sensitive,
                                        notebooks::Notebook::ORef selected_notebook)
   {
+    Results temp_matches;
+    search_notes(query, case_sensitive, selected_notebook, [&temp_matches](int match_count, NoteBase & note) {
+      temp_matches.insert(std::make_pair(match_count, std::ref(note)));
+    });
+    return temp_matches;
+  }
+
+
+  void Search::search_notes(const Glib::ustring & query, bool case_sensitive, notebooks::Notebook::ORef selected_notebook,
+                            const std::function<void(int, NoteBase&)> & func)
+  {
+    TRACE_SPAN("search_notes");
     Glib::ustring search_text = query;
     if(!case_sensitive) {
       search_text = search_text.lowercase();
@@ -49,21 +65,23 @@ namespace gnote {
     // Used for matching in the raw note XML
     std::vector<Glib::ustring> encoded_words;
     Search::split_watching_quotes(encoded_words, utils::XmlEncoder::encode(search_text));
-    Results temp_matches;
       
       // Skip over notes that are template notes
     Tag::Ptr template_tag = m_manager.tag_manager().get_or_create_system_tag(ITagManager::TEMPLATE_NOTE_SYSTEM_TAG);
 
-    m_manager.for_each([this, &temp_matches, template_tag, selected_notebook, case_sensitive, words=std::move(words), encoded_words=std::move(encoded_words)](NoteBase & note) {
+    // snapshot is consistent even if notes get added or deleted by func
+    auto notes = m_manager.notes_snapshot();
+    for(const NoteBase::Ptr & note_ptr : *notes) {
+      NoteBase & note = *note_ptr;
       // Skip template notes
       if(note.contains_tag(template_tag)) {
-        return;
+        continue;
       }
         
       // Skip notes that are not in the
       // selected notebook
       if(selected_notebook && !selected_notebook.value().get().contains_note(static_cast<Note&>(note))) {
-        return;
+        continue;
       }
         
       // First check the note's title for a match,
@@ -71,18 +89,15 @@ namespace gnote {
       // XML for at least one match, to avoid
       // deserializing Buffers unnecessarily.
       if(0 < find_match_count_in_note(note.get_title(), words, case_sensitive)) {
-        temp_matches.insert(std::make_pair(INT_MAX, std::ref(note)));
+        func(INT_MAX, note);
       }
       else if(check_note_has_match(note, encoded_words, case_sensitive)) {
         int match_count = find_match_count_in_note(note.text_content(), words, case_sensitive);
         if (match_count > 0) {
-          // TODO: Improve note.GetHashCode()
-          temp_matches.insert(std::make_pair(match_count, std::ref(note)));
+          func(match_count, note);
         }
       }
-    });
-
-    return temp_matches;
+    }
   }
 
   bool Search::check_note_has_match(const NoteBase & note,
@@ -147,4 +162,67 @@ namespace gnote {
   }
 
 
+  SearchResultCache::SearchResultCache(NoteManagerBase & manager, unsigned capacity)
+    : m_manager(manager)
+    , m_capacity(capacity)
+    , m_memory(memory::Category::CACHES)
+  {
+    m_manager.signal_note_added.connect(sigc::mem_fun(*this, &SearchResultCache::on_note_changed));
+    m_manager.signal_note_deleted.connect(sigc::mem_fun(*this, &SearchResultCache::on_note_changed));
+    m_manager.signal_note_saved.connect(sigc::mem_fun(*this, &SearchResultCache::on_note_changed));
+    m_manager.signal_note_renamed.connect(sigc::hide(sigc::mem_fun(*this, &SearchResultCache::on_note_changed)));
+  }
+
+
+  SearchResultCache::Entry & SearchResultCache::get_entry(const Glib::ustring & query, bool case_sensitive)
+  {
+    for(auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+      if(iter->case_sensitive == case_sensitive && iter->query == query) {
+        m_entries.splice(m_entries.begin(), m_entries, iter);
+        return m_entries.front();
+      }
+    }
+
+    std::size_t bytes = m_memory.bytes();
+    if(m_entries.size() >= m_capacity) {
+      bytes -= m_entries.back().bytes;
+      m_entries.pop_back();
+    }
+    m_entries.push_front(Entry{query, case_sensitive, {}, 0, 0});
+    Entry & entry = m_entries.front();
+    Search search(m_manager);
+    search.search_notes(query, case_sensitive, notebooks::Notebook::ORef(), [&entry](int match_count, NoteBase & note) {
+      entry.results.emplace_back(match_count, note.uri());
+      entry.bytes += note.uri().bytes();
+    });
+    entry.bytes += sizeof(Entry) + 2 * sizeof(void*) + query.bytes() + entry.results.capacity() * sizeof(Result);
+    m_memory.set(bytes + entry.bytes);
+    return entry;
+  }
+
+
+  std::size_t SearchResultCache::get_page(const Glib::ustring & query, bool case_sensitive, std::size_t offset, std::size_t limit,
+                                          std::vector<Result> & page)
+  {
+    Entry & entry = get_entry(query, case_sensitive);
+    auto & results = entry.results;
+    if(offset >= results.size()) {
+      return results.size();
+    }
+
+    // only order as many results as were requested so far
+    std::size_t end = offset + std::min(limit, results.size() - offset);
+    if(end > entry.sorted) {
+      auto compare = [](const Result & a, const Result & b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+      };
+      std::partial_sort(results.begin() + entry.sorted, results.begin() + end, results.end(), compare);
+      entry.sorted = end;
+    }
+
+    page.insert(page.end(), results.begin() + offset, results.begin() + end);
+    return results.size();
+  }
+
+
 }
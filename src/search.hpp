@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011,2013-2014,2017,2019,2023 Aurimas Cernius
  * Copyright (C) 2009 Hubert Figuiere
  *
@@ -23,9 +24,14 @@
 #ifndef __SEARCH_HPP_
 #define __SEARCH_HPP_
 
+#include <functional>
+#include <list>
 #include <map>
 #include <vector>
 
+#include <sigc++/trackable.h>
+
+#include "memoryusage.hpp"
 #include "note.hpp"
 #include "notebooks/notebook.hpp"
 #include "sharp/string.hpp"
@@ -33,6 +39,7 @@
 namespace gnote {
 
   class NoteManager;
+  class NoteManagerBase;
 
 class Search 
 {
@@ -67,6 +74,10 @@ public:
   /// number will be INT_MAX.
   /// </returns>  
   Results search_notes(const Glib::ustring &, bool, notebooks::Notebook::ORef);
+  /// Same as search_notes(), but calls func(match_count, note) for every match
+  /// instead of collecting results.
+  void search_notes(const Glib::ustring &, bool, notebooks::Notebook::ORef,
+                    const std::function<void(int, NoteBase&)> & func);
   bool check_note_has_match(const NoteBase & note, const std::vector<Glib::ustring> &, bool match_case);
   int find_match_count_in_note(Glib::ustring note_text, const std::vector<Glib::ustring> &,
                                bool match_case);
@@ -75,6 +86,51 @@ private:
   NoteManagerBase & m_manager;
 };
 
+
+/// Keeps results of recent searches, so that requesting further pages does not search again.
+/// Cached results are dropped when a note is added, saved, renamed or deleted,
+/// so unsaved edits and tag changes are not seen until the next save.
+class SearchResultCache
+  : public sigc::trackable
+{
+public:
+  typedef std::pair<int, Glib::ustring> Result; // match count and note uri
+
+  explicit SearchResultCache(NoteManagerBase & manager, unsigned capacity = 8);
+
+  /// Put at most limit best results starting at offset into page, ordered by match count descending.
+  /// Returns the total number of matching notes.
+  std::size_t get_page(const Glib::ustring & query, bool case_sensitive, std::size_t offset, std::size_t limit,
+                       std::vector<Result> & page);
+  void clear()
+    {
+      m_entries.clear();
+      m_memory.set(0);
+    }
+private:
+  struct Entry
+  {
+    Glib::ustring query;
+    bool case_sensitive;
+    std::vector<Result> results;
+    // results before this position are sorted and are the best ones
+    std::size_t sorted;
+    std::size_t bytes;
+  };
+
+  Entry & get_entry(const Glib::ustring & query, bool case_sensitive);
+  void on_note_changed(const NoteBase&)
+    {
+      clear();
+    }
+
+  NoteManagerBase & m_manager;
+  unsigned m_capacity;
+  std::list<Entry> m_entries;
+  memory::Tracker m_memory;
+};
+
+
 template<typename T>
 void Search::split_watching_quotes(std::vector<T> & split,
                                    const T & source)
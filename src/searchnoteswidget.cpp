@@ -138,18 +138,26 @@ public:
 private:
   ChangeColumnFactory(Preferences & prefs)
     : m_preferences(prefs)
+    , m_date_cache(true, prefs.desktop_gnome_clock_format() == "12h")
     {
+      prefs.signal_desktop_gnome_clock_format_changed.connect(sigc::mem_fun(*this, &ChangeColumnFactory::on_clock_format_changed));
     }
 
   Glib::ustring get_text(Gtk::ListItem & item) override
     {
       if(auto note = std::dynamic_pointer_cast<Note>(item.get_item())) {
-        return utils::get_pretty_print_date(note->change_date(), true, m_preferences);
+        return m_date_cache.get(note->change_date());
       }
       return Glib::ustring();
     }
 
+  void on_clock_format_changed()
+    {
+      m_date_cache.use_12h(m_preferences.desktop_gnome_clock_format() == "12h");
+    }
+
   Preferences & m_preferences;
+  utils::PrettyDateCache m_date_cache;
 };
 
 class NoteFilterModel
@@ -263,6 +271,8 @@ SearchNotesWidget::SearchNotesWidget(IGnote & g, NoteManagerBase & m)
   , m_matches_column(NULL)
   , m_initial_position_restored(false)
   , m_sort_column_order(Gtk::SortType::DESCENDING)
+  , m_bulk_notes_changed(false)
+  , m_bulk_notebooks_changed(false)
 {
   set_hexpand(true);
   set_vexpand(true);
@@ -284,6 +294,7 @@ SearchNotesWidget::SearchNotesWidget(IGnote & g, NoteManagerBase & m)
   m.signal_note_deleted.connect(sigc::mem_fun(*this, &SearchNotesWidget::on_note_deleted));
   m.signal_note_added.connect(sigc::mem_fun(*this, &SearchNotesWidget::on_note_added));
   m.signal_note_renamed.connect(sigc::mem_fun(*this, &SearchNotesWidget::on_note_renamed));
+  m.signal_bulk_mutation_ended.connect(sigc::mem_fun(*this, &SearchNotesWidget::on_bulk_mutation_ended));
 
   // Watch when notes are added to notebooks so the search
   // results will be updated immediately instead of waiting
@@ -422,10 +433,13 @@ void SearchNotesWidget::rename_notebook(const notebooks::Notebook& old_notebook,
   auto & new_notebook = notebook_manager.get_or_create_notebook(new_name);
   DBG_OUT("Renaming notebook '{%s}' to '{%s}'", old_notebook.get_name().c_str(), new_name.c_str());
   auto notes = old_notebook.get_tag()->get_notes();
-  for(NoteBase *note : notes) {
-    notebook_manager.move_note_to_notebook(static_cast<Note&>(*note), new_notebook);
+  {
+    NoteManagerBase::BulkMutation bulk(m_manager);
+    for(NoteBase *note : notes) {
+      notebook_manager.move_note_to_notebook(static_cast<Note&>(*note), new_notebook);
+    }
+    notebook_manager.delete_notebook(const_cast<notebooks::Notebook&>(old_notebook));
   }
-  notebook_manager.delete_notebook(const_cast<notebooks::Notebook&>(old_notebook));
   m_notebooks_view->select_notebook(new_notebook);
 }
 
@@ -574,10 +588,14 @@ void SearchNotesWidget::make_recent_notes_view()
     m_sort_column_order = Gtk::SortType::DESCENDING;
   }
 
+  // fill in change date order, so that the default sorting has nothing to do
   auto store = Gio::ListStore<Note>::create();
-  m_manager.copy_to(store, [this](const Glib::RefPtr<Gio::ListStore<Note>> & store, const NoteBase::Ptr & note_base) {
-    store->append(std::static_pointer_cast<Note>(note_base));
+  std::vector<Glib::RefPtr<Note>> notes;
+  notes.reserve(m_manager.note_count());
+  m_manager.for_each_by_change_date([&notes](NoteBase & note) {
+    notes.push_back(std::static_pointer_cast<Note>(note.shared_from_this()));
   });
+  store->splice(0, 0, notes);
   m_store = store;
   m_store_filter = NoteFilterModel::create(m_store);
   m_store_sort = Gtk::SortListModel::create(m_store_filter, m_notes_view->get_sorter());
@@ -779,12 +797,20 @@ bool SearchNotesWidget::show_all_search_results()
 
 void SearchNotesWidget::on_note_deleted(NoteBase & note)
 {
+  if(m_manager.in_bulk_mutation()) {
+    m_bulk_notes_changed = true;
+    return;
+  }
   restore_matches_window();
   delete_note(note);
 }
 
 void SearchNotesWidget::on_note_added(NoteBase & note)
 {
+  if(m_manager.in_bulk_mutation()) {
+    m_bulk_notes_changed = true;
+    return;
+  }
   restore_matches_window();
   add_note(note);
 }
@@ -808,8 +834,9 @@ void SearchNotesWidget::delete_note(NoteBase & note)
 
 void SearchNotesWidget::add_note(NoteBase & note)
 {
+  // most recently changed note goes first
   auto store = std::static_pointer_cast<Gio::ListStore<NoteBase>>(m_store);
-  store->append(note.shared_from_this());
+  store->insert(0, note.shared_from_this());
 }
 
 void SearchNotesWidget::rename_note(const NoteBase & note)
@@ -819,6 +846,30 @@ void SearchNotesWidget::rename_note(const NoteBase & note)
   add_note(n);
 }
 
+void SearchNotesWidget::on_bulk_mutation_ended()
+{
+  if(!m_bulk_notes_changed && !m_bulk_notebooks_changed) {
+    return;
+  }
+
+  restore_matches_window();
+  if(m_bulk_notes_changed) {
+    // replace everything at once, finding each note in store is linear
+    std::vector<Glib::RefPtr<Note>> notes;
+    notes.reserve(m_manager.note_count());
+    m_manager.for_each_by_change_date([&notes](NoteBase & note) {
+      notes.push_back(std::static_pointer_cast<Note>(note.shared_from_this()));
+    });
+    auto store = std::static_pointer_cast<Gio::ListStore<Note>>(m_store);
+    store->splice(0, store->get_n_items(), notes);
+  }
+  if(m_bulk_notebooks_changed) {
+    update_results();
+  }
+  m_bulk_notes_changed = false;
+  m_bulk_notebooks_changed = false;
+}
+
 void SearchNotesWidget::on_open_note(OpenNoteMode mode)
 {
   auto selected_notes = get_selected_notes();
@@ -893,12 +944,20 @@ Gtk::Window *SearchNotesWidget::get_owning_window()
 
 void SearchNotesWidget::on_note_added_to_notebook(const Note &, const notebooks::Notebook &)
 {
+  if(m_manager.in_bulk_mutation()) {
+    m_bulk_notebooks_changed = true;
+    return;
+  }
   restore_matches_window();
   update_results();
 }
 
 void SearchNotesWidget::on_note_removed_from_notebook(const Note &, const notebooks::Notebook &)
 {
+  if(m_manager.in_bulk_mutation()) {
+    m_bulk_notebooks_changed = true;
+    return;
+  }
   restore_matches_window();
   update_results();
 }
@@ -96,6 +96,7 @@ private:
   void delete_note(NoteBase & note);
   void add_note(NoteBase & note);
   void rename_note(const NoteBase & note);
+  void on_bulk_mutation_ended();
 
   enum class OpenNoteMode
   {
@@ -162,6 +163,9 @@ private:
   Glib::ustring m_search_text;
   Glib::RefPtr<const Gtk::ColumnViewColumn> m_sort_column;
   Gtk::SortType m_sort_column_order;
+  // changes seen during bulk mutation, applied when it ends
+  bool m_bulk_notes_changed;
+  bool m_bulk_notebooks_changed;
 };
 
 }
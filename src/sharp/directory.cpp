@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011-2014,2017-2019,2022 Aurimas Cernius
  * Copyright (C) 2011 Debarshi Ray
  * Copyright (C) 2009 Hubert Figuiere
@@ -26,12 +27,15 @@
 
 
 
+#include <cerrno>
+#include <cstring>
+
+#include <dirent.h>
 #include <glib/gstdio.h>
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
 #include "sharp/directory.hpp"
-#include "sharp/fileinfo.hpp"
 #include "sharp/string.hpp"
 
 #include "debug.hpp"
@@ -39,27 +43,53 @@
 namespace sharp {
 
 
+  namespace {
+
+  bool has_extension(const char *name, const Glib::ustring & ext)
+  {
+    if(ext.empty()) {
+      return true;
+    }
+    const char *dot = std::strrchr(name, '.');
+    return dot && g_ascii_strcasecmp(dot, ext.c_str()) == 0;
+  }
+
+  }
+
+
   std::vector<Glib::ustring> directory_get_files_with_ext(const Glib::ustring & dir, const Glib::ustring & ext)
   {
     std::vector<Glib::ustring> list;
-    if (!Glib::file_test(dir, Glib::FileTest::EXISTS))
-      return list;
-
     if (!Glib::file_test(dir, Glib::FileTest::IS_DIR))
       return list;
 
-    Glib::Dir d(dir);
-
-    for (Glib::Dir::iterator itr = d.begin(); itr != d.end(); ++itr) {
-      const Glib::ustring file(dir + "/" + *itr);
-      const sharp::FileInfo file_info(file);
-      const Glib::ustring extension = file_info.get_extension();
+    DIR *d = opendir(dir.c_str());
+    if(!d) {
+      int err = errno;
+      throw Glib::FileError(Glib::FileError::Code(g_file_error_from_errno(err)),
+                            Glib::ustring::compose("Failed to open directory %1: %2", dir, g_strerror(err)));
+    }
 
-      if (Glib::file_test(file, Glib::FileTest::IS_REGULAR)
-          && (ext.empty() || (Glib::ustring(extension).lowercase() == ext))) {
+    // match the name first and only stat entries the directory listing does not give type for
+    while(struct dirent *entry = readdir(d)) {
+      if(!has_extension(entry->d_name, ext)) {
+        continue;
+      }
+      const Glib::ustring file(dir + "/" + entry->d_name);
+#ifdef _DIRENT_HAVE_D_TYPE
+      if(entry->d_type == DT_REG) {
+        list.push_back(file);
+        continue;
+      }
+      if(entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK) {
+        continue;
+      }
+#endif
+      if(Glib::file_test(file, Glib::FileTest::IS_REGULAR)) {
         list.push_back(file);
       }
     }
+    closedir(d);
 
     return list;
   }
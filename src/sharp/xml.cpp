@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2012,2017 Aurimas Cernius
  * Copyright (C) 2009 Hubert Figuiere
  * 
@@ -26,6 +27,10 @@
 
 
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
 #include <libxml/xpath.h>
 
 #include "sharp/xml.hpp"
@@ -33,6 +38,391 @@
 
 namespace sharp {
 
+  namespace {
+
+  inline bool is_xml_space(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n';
+  }
+
+  inline bool is_name_start_char(unsigned char c)
+  {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' || c >= 0x80;
+  }
+
+  inline bool is_name_char(unsigned char c)
+  {
+    return is_name_start_char(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+  }
+
+  // character data that needs a closer look
+  inline bool is_text_special(unsigned char c)
+  {
+    return c == '<' || c == '&' || c == ']' || c == 0xEF || c < 0x20;
+  }
+
+  const char *parse_xml_name(const char *p, const char *end)
+  {
+    if(p == end || !is_name_start_char(*p)) {
+      return nullptr;
+    }
+    ++p;
+    while(p < end && is_name_char(*p)) {
+      ++p;
+    }
+    return p;
+  }
+
+  // namespace prefix of a qualified name, empty if none
+  // returns false if name is not a valid qualified name
+  bool xml_name_prefix(std::string_view name, std::string_view & prefix)
+  {
+    auto colon = name.find(':');
+    if(colon == std::string_view::npos) {
+      prefix = std::string_view();
+      return true;
+    }
+    if(colon == 0 || colon + 1 == name.size() || name.find(':', colon + 1) != std::string_view::npos) {
+      return false;
+    }
+    prefix = name.substr(0, colon);
+    return true;
+  }
+
+  // only accept plain absolute URIs, libxml warns about others
+  bool is_absolute_uri(std::string_view uri)
+  {
+    if(uri.empty() || !g_ascii_isalpha(uri[0])) {
+      return false;
+    }
+    std::size_t i = 1;
+    while(i < uri.size() && (g_ascii_isalnum(uri[i]) || uri[i] == '+' || uri[i] == '-' || uri[i] == '.')) {
+      ++i;
+    }
+    if(i == uri.size() || uri[i] != ':') {
+      return false;
+    }
+    for(++i; i < uri.size(); ++i) {
+      if(!g_ascii_isalnum(uri[i]) && !std::strchr("-._~:/?#@!$()*+,;=", uri[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool append_xml_reference(const char *&p, const char *end, std::string & out)
+  {
+    const char *semicolon = static_cast<const char*>(std::memchr(p, ';', std::min<std::ptrdiff_t>(end - p, 12)));
+    if(!semicolon) {
+      return false;
+    }
+    std::string_view ref(p + 1, semicolon - p - 1);
+    p = semicolon + 1;
+    if(ref == "lt") {
+      out += '<';
+    }
+    else if(ref == "gt") {
+      out += '>';
+    }
+    else if(ref == "amp") {
+      out += '&';
+    }
+    else if(ref == "quot") {
+      out += '"';
+    }
+    else if(ref == "apos") {
+      out += '\'';
+    }
+    else if(ref.size() > 1 && ref[0] == '#') {
+      bool hex = ref[1] == 'x';
+      std::size_t i = hex ? 2 : 1;
+      if(i == ref.size()) {
+        return false;
+      }
+      guint32 ch = 0;
+      for(; i < ref.size(); ++i) {
+        char c = ref[i];
+        int digit;
+        if(c >= '0' && c <= '9') {
+          digit = c - '0';
+        }
+        else if(hex && c >= 'a' && c <= 'f') {
+          digit = c - 'a' + 10;
+        }
+        else if(hex && c >= 'A' && c <= 'F') {
+          digit = c - 'A' + 10;
+        }
+        else {
+          return false;
+        }
+        ch = ch * (hex ? 16 : 10) + digit;
+        if(ch > 0x10FFFF) {
+          return false;
+        }
+      }
+      bool valid = ch == 0x9 || ch == 0xA || ch == 0xD || (ch >= 0x20 && ch <= 0xD7FF)
+        || (ch >= 0xE000 && ch <= 0xFFFD) || ch >= 0x10000;
+      if(!valid) {
+        return false;
+      }
+      char buf[6];
+      out.append(buf, g_unichar_to_utf8(ch, buf));
+    }
+    else {
+      return false;
+    }
+    return true;
+  }
+
+  struct XmlAttribute
+  {
+    std::string_view name;
+    std::string_view value;
+  };
+
+  struct XmlNamespace
+  {
+    std::string_view prefix;
+    // number of elements open when declared
+    std::size_t depth;
+  };
+
+  bool is_declared(const std::vector<XmlNamespace> & namespaces, std::string_view prefix)
+  {
+    for(auto & ns : namespaces) {
+      if(ns.prefix == prefix) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // checks and registers namespace declarations and prefixes used in start tag
+  bool check_namespaces(std::string_view element, const std::vector<XmlAttribute> & attributes, std::vector<XmlNamespace> & namespaces, std::size_t depth)
+  {
+    for(auto & attribute : attributes) {
+      if(attribute.name == "xmlns") {
+        if(!is_absolute_uri(attribute.value)) {
+          return false;
+        }
+      }
+      else if(attribute.name.substr(0, 6) == "xmlns:") {
+        auto prefix = attribute.name.substr(6);
+        if(prefix.find(':') != std::string_view::npos || prefix.substr(0, 3) == "xml" || !is_absolute_uri(attribute.value)) {
+          return false;
+        }
+        namespaces.push_back(XmlNamespace{prefix, depth});
+      }
+    }
+
+    std::string_view prefix;
+    if(!xml_name_prefix(element, prefix) || (!prefix.empty() && !is_declared(namespaces, prefix))) {
+      return false;
+    }
+    std::string_view other_prefix;
+    for(auto iter = attributes.begin(); iter != attributes.end(); ++iter) {
+      if(!xml_name_prefix(iter->name, prefix)) {
+        return false;
+      }
+      if(prefix.empty() || prefix == "xmlns") {
+        continue;
+      }
+      if(!is_declared(namespaces, prefix)) {
+        return false;
+      }
+      // same local name in different prefixes might be the same attribute
+      auto local_name = iter->name.substr(prefix.size() + 1);
+      for(auto other = attributes.begin(); other != iter; ++other) {
+        if(xml_name_prefix(other->name, other_prefix) && !other_prefix.empty() && other->name.substr(other_prefix.size() + 1) == local_name) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  void pop_namespaces(std::vector<XmlNamespace> & namespaces, std::size_t depth)
+  {
+    while(!namespaces.empty() && namespaces.back().depth >= depth) {
+      namespaces.pop_back();
+    }
+  }
+
+  }
+
+
+  bool xml_extract_text(const char *p, const char *end, std::string & out, const char *break_element)
+  {
+    std::vector<std::string_view> open_elements;
+    std::vector<XmlAttribute> attributes;
+    std::vector<XmlNamespace> namespaces;
+    bool root_seen = false;
+
+    while(p < end) {
+      if(*p == '<') {
+        ++p;
+        if(p < end && *p == '/') {
+          const char *name = ++p;
+          p = parse_xml_name(p, end);
+          if(!p || open_elements.empty() || open_elements.back() != std::string_view(name, p - name)) {
+            return false;
+          }
+          open_elements.pop_back();
+          pop_namespaces(namespaces, open_elements.size());
+          while(p < end && is_xml_space(*p)) {
+            ++p;
+          }
+          if(p == end || *p != '>') {
+            return false;
+          }
+          ++p;
+          continue;
+        }
+
+        // only one root element
+        if(root_seen && open_elements.empty()) {
+          return false;
+        }
+        const char *name = p;
+        p = parse_xml_name(p, end);
+        if(!p) {
+          return false;
+        }
+        std::string_view element(name, p - name);
+        bool empty_element = false;
+        attributes.clear();
+        while(true) {
+          const char *space = p;
+          while(p < end && is_xml_space(*p)) {
+            ++p;
+          }
+          if(p == end) {
+            return false;
+          }
+          if(*p == '>') {
+            ++p;
+            break;
+          }
+          if(*p == '/') {
+            if(p + 1 < end && p[1] == '>') {
+              p += 2;
+              empty_element = true;
+              break;
+            }
+            return false;
+          }
+          if(p == space) {
+            return false;
+          }
+
+          const char *attribute = p;
+          p = parse_xml_name(p, end);
+          if(!p) {
+            return false;
+          }
+          std::string_view attribute_name(attribute, p - attribute);
+          for(auto & other : attributes) {
+            if(other.name == attribute_name) {
+              return false;
+            }
+          }
+          while(p < end && is_xml_space(*p)) {
+            ++p;
+          }
+          if(p == end || *p != '=') {
+            return false;
+          }
+          ++p;
+          while(p < end && is_xml_space(*p)) {
+            ++p;
+          }
+          if(p == end || (*p != '"' && *p != '\'')) {
+            return false;
+          }
+          char quote = *p++;
+          const char *value = p;
+          for(; p < end && *p != quote; ++p) {
+            if(*p == '<' || *p == '&' || static_cast<unsigned char>(*p) < 0x20) {
+              return false;
+            }
+          }
+          if(p == end) {
+            return false;
+          }
+          attributes.push_back(XmlAttribute{attribute_name, std::string_view(value, p - value)});
+          ++p;
+        }
+
+        if(!check_namespaces(element, attributes, namespaces, open_elements.size())) {
+          return false;
+        }
+        root_seen = true;
+        if(break_element && element == break_element) {
+          out += '\n';
+        }
+        if(empty_element) {
+          pop_namespaces(namespaces, open_elements.size());
+        }
+        else {
+          open_elements.push_back(element);
+        }
+        continue;
+      }
+
+      if(open_elements.empty()) {
+        // outside of root element only whitespace is allowed and it is not part of text
+        if(!is_xml_space(*p)) {
+          return false;
+        }
+        ++p;
+        continue;
+      }
+
+      const char *run = p;
+      while(p < end && !is_text_special(*p)) {
+        ++p;
+      }
+      out.append(run, p - run);
+      if(p == end) {
+        break;
+      }
+
+      unsigned char c = *p;
+      if(c == '<') {
+        continue;
+      }
+      if(c == '&') {
+        if(!append_xml_reference(p, end, out)) {
+          return false;
+        }
+      }
+      else if(c == ']') {
+        if(end - p >= 3 && p[1] == ']' && p[2] == '>') {
+          return false;
+        }
+        out += *p++;
+      }
+      else if(c == 0xEF) {
+        // U+FFFE and U+FFFF are not allowed in XML
+        if(end - p >= 3 && static_cast<unsigned char>(p[1]) == 0xBF && (static_cast<unsigned char>(p[2]) & 0xFE) == 0xBE) {
+          return false;
+        }
+        out += *p++;
+      }
+      else if(c == '\t' || c == '\n') {
+        out += *p++;
+      }
+      else {
+        // other control characters are invalid, carriage return gets normalized by libxml
+        return false;
+      }
+    }
+
+    return root_seen && open_elements.empty();
+  }
+
+
   XmlNodeSet xml_node_xpath_find(const xmlNodePtr node, 
                                  const char * xpath)
   {
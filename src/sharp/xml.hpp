@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2012,2017 Aurimas Cernius
  * Copyright (C) 2009 Hubert Figuiere
  * 
@@ -29,6 +30,7 @@
 #ifndef __SHARP_XML_HPP_
 #define __SHARP_XML_HPP_
 
+#include <string>
 #include <vector>
 
 #include <glibmm/ustring.h>
@@ -53,6 +55,12 @@ namespace sharp {
   Glib::ustring xml_node_get_attribute(const xmlNodePtr node,
                                        const char * attr_name);
 
+  /// Appends text content of XML document to out without building a tree.
+  /// Appends a newline for every start of break_element, if given.
+  /// Only handles elements, attributes and predefined or character references. Returns false for
+  /// anything else (comments, CDATA, processing instructions, malformed input), out is then incomplete.
+  bool xml_extract_text(const char *begin, const char *end, std::string & out, const char *break_element = nullptr);
+
 }
 
 
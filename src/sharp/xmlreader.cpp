@@ -28,6 +28,7 @@
 #include <glibmm/i18n.h>
 
 #include "debug.hpp"
+#include "tracing.hpp"
 
 #include "sharp/xmlreader.hpp"
 
@@ -78,6 +79,7 @@ namespace sharp {
     , m_reader(NULL)
     , m_error(false)
   {
+    TRACE_OP(XML_PARSE);
     m_reader = xmlNewTextReaderFilename(filename.c_str());
     m_error = (m_reader == NULL);
     if(m_reader) {
@@ -99,6 +101,7 @@ namespace sharp {
   {
     close();
     m_buffer = s;
+    TRACE_OP(XML_PARSE);
     // use bytes() instead of size(), because of multibyte Unicode characters (need proper C-string length
     m_reader = xmlReaderForMemory(m_buffer.c_str(), m_buffer.bytes(), "",
                                   "UTF-8", 0);//XML_PARSE_RECOVER);
@@ -89,4 +89,30 @@ void XslTransform::transform(xmlDocPtr doc, const XsltArgumentList & args, Strea
   }
 }
 
+
+std::string XslTransform::transform_to_string(xmlDocPtr doc, const XsltArgumentList & args)
+{
+  if(m_stylesheet == NULL) {
+    ERR_OUT(_("NULL stylesheet, please fill a bug"));
+    return "";
+  }
+
+  const char **params = args.get_xlst_params();
+  xmlDocPtr res = xsltApplyStylesheet(m_stylesheet, doc, params);
+  free(params);
+  if(!res) {
+    throw(sharp::Exception("XSLT Error"));
+  }
+
+  xmlChar *output = NULL;
+  int length = 0;
+  std::string result;
+  if(xsltSaveResultToString(&output, &length, res, m_stylesheet) == 0 && output) {
+    result.assign(reinterpret_cast<const char*>(output), length);
+  }
+  xmlFree(output);
+  xmlFreeDoc(res);
+  return result;
+}
+
 }
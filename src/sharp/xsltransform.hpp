@@ -30,6 +30,7 @@
 #define __SHARP_XSLTRANSFORM_HPP_
 
 #include <map>
+#include <string>
 
 #include <libxml/tree.h>
 #include <libxslt/transform.h>
@@ -52,6 +53,8 @@ public:
   void load(const Glib::ustring &);
   /** run the XLS transformation */
   void transform(xmlDocPtr, const XsltArgumentList &, StreamWriter &, const XmlResolver &);
+  /** run the XLS transformation, returning the result */
+  std::string transform_to_string(xmlDocPtr, const XsltArgumentList &);
 
 private:
   xsltStylesheetPtr m_stylesheet;
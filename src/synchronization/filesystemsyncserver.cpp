@@ -20,6 +20,8 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 
 #include <glibmm/i18n.h>
@@ -34,6 +36,7 @@
 #include "sharp/xml.hpp"
 #include "sharp/xmlreader.hpp"
 #include "sharp/xmlwriter.hpp"
+#include "tracing.hpp"
 
 
 namespace {
@@ -48,6 +51,64 @@ int str_to_int(const Glib::ustring & s)
   }
 }
 
+
+// what was seen last time when probing manifest for revision
+struct ManifestProbe
+{
+  Glib::ustring etag;
+  guint64 mtime;
+  guint32 mtime_usec;
+  goffset size;
+  int revision;
+};
+
+// servers are created for every autosync check, so keep it for the lifetime of the process
+std::mutex s_manifest_probes_lock;
+std::map<Glib::ustring, ManifestProbe> s_manifest_probes;
+
+
+int read_input_stream(void *context, char *buffer, int len)
+{
+  try {
+    return static_cast<Gio::InputStream*>(context)->read(buffer, len);
+  }
+  catch(Glib::Error & e) {
+    ERR_OUT(_("Failed to read manifest: %s"), e.what());
+    return -1;
+  }
+}
+
+
+// reads just the revision attribute of root element, without reading rest of the file
+bool read_manifest_revision(const Glib::RefPtr<Gio::File> & manifest, int & revision)
+{
+  auto stream = manifest->read();
+  TRACE_OP(XML_PARSE);
+  xmlTextReaderPtr reader = xmlReaderForIO(read_input_stream, NULL, stream.get(), manifest->get_uri().c_str(), "UTF-8", 0);
+  if(!reader) {
+    return false;
+  }
+
+  bool found = false;
+  while(xmlTextReaderRead(reader) == 1) {
+    if(xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
+      continue;
+    }
+    if(xmlStrEqual(xmlTextReaderConstName(reader), (const xmlChar*)"sync")) {
+      xmlChar *value = xmlTextReaderGetAttribute(reader, (const xmlChar*)"revision");
+      if(value) {
+        found = *value != 0;
+        revision = str_to_int((const char*)value);
+        xmlFree(value);
+      }
+    }
+    break;
+  }
+  xmlFreeTextReader(reader);
+  stream->close();
+  return found;
+}
+
 }
 
 
@@ -77,9 +138,8 @@ void FileSystemSyncServer::common_ctor()
 
   m_lock_path = m_server_path->get_child("lock");
   m_manifest_path = m_server_path->get_child("manifest.xml");
-
-  m_new_revision = latest_revision() + 1;
-  m_new_revision_path = get_revision_dir_path(m_new_revision);
+  // new revision is determined when transaction begins, creating server for autosync check has to be cheap
+  m_new_revision = -1;
 
   m_lock_timeout.signal_timeout
     .connect(sigc::mem_fun(*this, &FileSystemSyncServer::lock_timeout));
@@ -172,10 +232,60 @@ std::vector<Glib::ustring> FileSystemSyncServer::get_all_note_uuids()
 
 bool FileSystemSyncServer::updates_available_since(int revision)
 {
+  int latest_rev;
+  if(probe_manifest_revision(latest_rev)) {
+    return latest_rev > revision;
+  }
   return latest_revision() > revision; // TODO: Mounting, etc?
 }
 
 
+bool FileSystemSyncServer::probe_manifest_revision(int & revision)
+{
+  Glib::RefPtr<Gio::FileInfo> info;
+  try {
+    info = m_manifest_path->query_info(G_FILE_ATTRIBUTE_ETAG_VALUE "," G_FILE_ATTRIBUTE_TIME_MODIFIED ","
+                                       G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC "," G_FILE_ATTRIBUTE_STANDARD_SIZE);
+  }
+  catch(Gio::Error &) {
+    // no manifest, let the full check look for revision directories
+    return false;
+  }
+
+  ManifestProbe probe;
+  probe.etag = info->get_etag();
+  probe.mtime = info->get_attribute_uint64(G_FILE_ATTRIBUTE_TIME_MODIFIED);
+  probe.mtime_usec = info->get_attribute_uint32(G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC);
+  probe.size = info->get_size();
+  // nothing to compare
+  if(probe.etag.empty() && probe.mtime == 0) {
+    return false;
+  }
+
+  const Glib::ustring uri = m_manifest_path->get_uri();
+  {
+    std::lock_guard<std::mutex> lock(s_manifest_probes_lock);
+    auto iter = s_manifest_probes.find(uri);
+    if(iter != s_manifest_probes.end()) {
+      const ManifestProbe & last = iter->second;
+      if(last.etag == probe.etag && last.mtime == probe.mtime && last.mtime_usec == probe.mtime_usec && last.size == probe.size) {
+        revision = last.revision;
+        return true;
+      }
+    }
+  }
+
+  DBG_OUT("Manifest changed, reading revision from %s", uri.c_str());
+  if(!read_manifest_revision(m_manifest_path, probe.revision)) {
+    return false;
+  }
+  revision = probe.revision;
+  std::lock_guard<std::mutex> lock(s_manifest_probes_lock);
+  s_manifest_probes[uri] = std::move(probe);
+  return true;
+}
+
+
 std::map<Glib::ustring, NoteUpdate> FileSystemSyncServer::get_note_updates_since(int revision)
 {
   std::mutex note_updates_lock;
@@ -283,6 +393,9 @@ bool FileSystemSyncServer::begin_sync_transaction()
     }
   }
 
+  m_new_revision = latest_revision() + 1;
+  m_new_revision_path = get_revision_dir_path(m_new_revision);
+
   // Create a new lock file so other clients know another client is
   // actively synchronizing right now.
   m_sync_lock.renew_count = 0;
@@ -695,6 +808,7 @@ bool FileSystemSyncServer::is_valid_xml_file(const Glib::RefPtr<Gio::File> & xml
   while(read == buf_size);
   stream->close();
   auto xml_string = os.str();
+  TRACE_OP(XML_PARSE);
   xmlDocPtr xml = xmlReadMemory(xml_string.c_str(), xml_string.size(), xmlFile->get_uri().c_str(), "UTF-8", 0);
   if(!xml) {
     return false;
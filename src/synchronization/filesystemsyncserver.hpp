@@ -56,6 +56,9 @@ private:
   void cleanup_old_sync(const SyncLockInfo & syncLockInfo);
   void update_lock_file(const SyncLockInfo & syncLockInfo);
   bool is_valid_xml_file(const Glib::RefPtr<Gio::File> & xmlFilePath, xmlDocPtr *xml_doc);
+  /// Gets revision cheaply, comparing manifest file info to the one seen last time.
+  /// Returns false if full check is required.
+  bool probe_manifest_revision(int & revision);
   void lock_timeout();
 
   std::vector<Glib::ustring> m_updated_notes;
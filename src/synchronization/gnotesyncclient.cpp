@@ -32,6 +32,7 @@
 #include "sharp/files.hpp"
 #include "sharp/xmlreader.hpp"
 #include "sharp/xmlwriter.hpp"
+#include "tracing.hpp"
 
 
 namespace gnote {
@@ -187,6 +188,7 @@ namespace sync {
       m_last_sync_date = Glib::DateTime::create_now_utc();
     }
 
+    TRACE_OP(FILE_WRITE);
     sharp::XmlWriter xml(manifest_path);
 
     try {
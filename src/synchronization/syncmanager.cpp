@@ -20,6 +20,8 @@
 
 #include "config.h"
 
+#include <unordered_map>
+
 #include <glibmm/i18n.h>
 #include <sigc++/sigc++.h>
 
@@ -34,17 +36,115 @@
 #include "silentui.hpp"
 #include "syncmanager.hpp"
 #include "syncserviceaddin.hpp"
+#include "tracing.hpp"
+#include "utils.hpp"
+#include "base/hash.hpp"
 #include "sharp/xmlreader.hpp"
 
 
 namespace gnote {
 namespace sync {
 
+  namespace {
+
+  const char *trace_phase_name(SyncState state)
+  {
+    switch(state) {
+    case CONNECTING:
+      return "sync_connecting";
+    case ACQUIRING_LOCK:
+      return "sync_acquiring_lock";
+    case PREPARE_DOWNLOAD:
+      return "sync_prepare_download";
+    case DOWNLOADING:
+      return "sync_downloading";
+    case PREPARE_UPLOAD:
+      return "sync_prepare_upload";
+    case UPLOADING:
+      return "sync_uploading";
+    case DELETE_SERVER_NOTES:
+      return "sync_delete_server_notes";
+    case COMMITTING_CHANGES:
+      return "sync_committing_changes";
+    default:
+      return nullptr;
+    }
+  }
+
+
+  // Snapshot of the notes, that is released on the main thread.
+  // It can hold the last reference to a note deleted meanwhile and note destruction touches GTK.
+  class MainThreadSnapshot
+  {
+  public:
+    explicit MainThreadSnapshot(const NoteManagerBase & manager)
+      : m_notes(manager.notes_snapshot())
+      {}
+    ~MainThreadSnapshot()
+      {
+        utils::main_context_call([this]() { m_notes.reset(); });
+      }
+    MainThreadSnapshot(const MainThreadSnapshot&) = delete;
+    MainThreadSnapshot & operator=(const MainThreadSnapshot&) = delete;
+
+    const std::vector<NoteBase::Ptr> & operator*() const
+      {
+        return *m_notes;
+      }
+  private:
+    NoteManagerBase::NotesSnapshot m_notes;
+  };
+
+
+  // Case insensitive title lookup for one sync run, NoteManagerBase::find() scans all notes on every call
+  class TitleIndex
+  {
+  public:
+    explicit TitleIndex(NoteManagerBase & manager)
+      : m_manager(manager)
+      {
+        TRACE_OP(REGISTRY_SCAN);
+        MainThreadSnapshot notes(manager);
+        for(const auto & note : *notes) {
+          add(*note);
+        }
+      }
+
+    void add(const NoteBase & note)
+      {
+        // replaces a note deleted for having the same title
+        m_uris[note.get_title().lowercase()] = note.uri();
+      }
+
+    // notes renamed after being indexed are not found by their new title
+    NoteBase::ORef find(const Glib::ustring & title) const
+      {
+        Glib::ustring key = title.lowercase();
+        auto iter = m_uris.find(key);
+        if(iter == m_uris.end()) {
+          return NoteBase::ORef();
+        }
+        auto note = m_manager.find_by_uri(iter->second);
+        if(note && note.value().get().get_title().lowercase() == key) {
+          return note;
+        }
+        return NoteBase::ORef();
+      }
+  private:
+    NoteManagerBase & m_manager;
+    std::unordered_map<Glib::ustring, Glib::ustring, Hash<Glib::ustring>> m_uris;
+  };
+
+  }
+
+
   SyncManager::SyncManager(IGnote & g, NoteManagerBase & m)
     : m_gnote(g)
     , m_note_manager(m)
     , m_state(IDLE)
     , m_sync_thread(NULL)
+    , m_trace_phase(nullptr)
+    , m_trace_phase_start(0)
   {
   }
 
@@ -143,6 +243,7 @@ namespace sync {
         }
       }
     } f(*this);
+    TRACE_SPAN("sync");
     std::unique_ptr<SyncServer> server;
     try {
       f.addin = get_configured_sync_service();
@@ -221,9 +322,10 @@ namespace sync {
       // TODO: Lots of searching here and in the next foreach...
       //       Want this stuff to happen all at once first, but
       //       maybe there's a way to store this info and pass it on?
+      TitleIndex titles(note_mgr());
       for(auto & iter : noteUpdates) {
         if(find_note_by_uuid(iter.second.m_uuid)) {
-          auto existingNote = note_mgr().find(iter.second.m_title);
+          auto existingNote = titles.find(iter.second.m_title);
           if(existingNote && !iter.second.basically_equal_to(existingNote.value())) {
             DBG_OUT("Sync: Early conflict detection for '%s'", iter.second.m_title.c_str());
             if(m_sync_ui != 0) {
@@ -248,12 +350,15 @@ namespace sync {
           // template notes (if a note with a new tag syncs
           // before its associated template). So check by
           // title and delete if necessary.
-          auto existingNote = note_mgr().find(iter.second.m_title);
+          auto existingNote = titles.find(iter.second.m_title);
           if(existingNote) {
             DBG_OUT("SyncManager: Deleting auto-generated note: %s", iter.second.m_title.c_str());
             delete_note_in_main_thread(existingNote.value());
           }
           create_note_in_main_thread(iter.second);
+          if(auto created = find_note_by_uuid(iter.second.m_uuid)) {
+            titles.add(created.value());
+          }
         }
         else {
           NoteBase & existing = existing_note.value();
@@ -276,6 +381,9 @@ namespace sync {
             else {
               // Note has been deleted or okay'd for overwrite
               create_note_in_main_thread(iter.second);
+              if(auto created = find_note_by_uuid(iter.second.m_uuid)) {
+                titles.add(created.value());
+              }
             }
           }
         }
@@ -293,7 +401,10 @@ namespace sync {
       // Look through all the notes modified on the client
       // and upload new or modified ones to the server
       std::vector<NoteBase::Ref> new_or_modified_notes;
-      note_mgr().for_each([this, &new_or_modified_notes](NoteBase & note) {
+      // snapshot, main thread can add or delete notes meanwhile
+      MainThreadSnapshot notes(note_mgr());
+      for(const NoteBase::Ptr & note_ptr : *notes) {
+        NoteBase & note = *note_ptr;
         if(m_client->get_revision(note) == -1) {
           // This is a new note that has never been synchronized to the server
           // TODO: *OR* this is a note that we lost revision info for!!!
@@ -311,7 +422,7 @@ namespace sync {
             m_sync_ui->note_synchronized_th(note.get_title(), UPLOAD_MODIFIED);
           }
         }
-      });
+      }
 
       DBG_OUT("Sync: Uploading %zu note updates", new_or_modified_notes.size());
       if(new_or_modified_notes.size() > 0) {
@@ -512,6 +623,15 @@ namespace sync {
 
   void SyncManager::set_state(SyncState new_state)
   {
+    // each phase lasts until the next state change
+    if(tracing::enabled()) {
+      auto now = tracing::now();
+      if(m_trace_phase) {
+        tracing::record_span(m_trace_phase, m_trace_phase_start, now);
+      }
+      m_trace_phase = trace_phase_name(new_state);
+      m_trace_phase_start = now;
+    }
     m_state = new_state;
     if(m_sync_ui != 0) {
       // Notify the event handlers
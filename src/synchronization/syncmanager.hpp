@@ -22,6 +22,7 @@
 #define _SYNCHRONIZATION_SYNCMANAGER_HPP_
 
 
+#include <cstdint>
 #include <map>
 #include <thread>
 
@@ -91,6 +92,9 @@ namespace sync {
     int m_autosync_timeout_pref_minutes;
     int m_current_autosync_timeout_minutes;
     Glib::DateTime m_last_background_check;
+    // sync phase being traced and its start time
+    const char *m_trace_phase;
+    std::int64_t m_trace_phase_start;
   };
 
 
@@ -37,6 +37,8 @@ namespace gnote {
   Tag::Tag(Glib::ustring && _name)
     : m_issystem(false)
     , m_isproperty(false)
+    , m_notes_bytes(0)
+    , m_memory(memory::Category::TAGS)
   {
     set_name(std::move(_name));
   }
@@ -45,6 +47,8 @@ namespace gnote {
   {
     if(m_notes.find(note.uri()) == m_notes.end()) {
       m_notes[note.uri()] = &note;
+      m_notes_bytes += note.uri().bytes();
+      update_memory();
     }
   }
 
@@ -53,11 +57,26 @@ namespace gnote {
   {
     NoteMap::iterator iter = m_notes.find(note.uri());
     if(iter != m_notes.end()) {
+      m_notes_bytes -= iter->first.bytes();
       m_notes.erase(iter);
+      update_memory();
     }
   }
 
 
+  // Each tagged note is a node in m_notes and another in the note's own tag map,
+  // the tag itself is also kept in TagManager, keyed by normalized name.
+  void Tag::update_memory()
+  {
+    typedef std::map<Glib::ustring, Ptr>::value_type NoteTagMapEntry;
+    m_memory.set(sizeof(Tag) + m_name.raw().capacity() + 2 * m_normalized_name.raw().capacity()
+                 + memory::tree_node_bytes<NoteMap::value_type>()
+                 + m_notes.size() * (memory::tree_node_bytes<NoteMap::value_type>()
+                                     + memory::tree_node_bytes<NoteTagMapEntry>())
+                 + 2 * m_notes_bytes);
+  }
+
+
   void Tag::set_name(Glib::ustring && value)
   {
     if (!value.empty()) {
@@ -71,6 +90,7 @@ namespace gnote {
         std::vector<Glib::ustring> splits;
         sharp::string_split(splits, value, ":");
         m_isproperty  = (splits.size() >= 3);
+        update_memory();
       }
     }
   }
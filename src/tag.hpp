@@ -30,6 +30,8 @@
 
 #include <glibmm/ustring.h>
 
+#include "memoryusage.hpp"
+
 namespace gnote {
 
   enum ChangeType {
@@ -99,6 +101,8 @@ namespace gnote {
 /////
 
   private:
+    void update_memory();
+
     Glib::ustring m_name;
     Glib::ustring m_normalized_name;
     bool        m_issystem;
@@ -109,6 +113,9 @@ namespace gnote {
     // </summary>
     typedef std::map<Glib::ustring, NoteBase*> NoteMap;
     NoteMap m_notes;
+    // URIs of tagged notes, both here and in NoteData::tags()
+    std::size_t m_notes_bytes;
+    memory::Tracker m_memory;
   };
 
 
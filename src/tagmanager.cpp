@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2011,2013-2014,2017,2019,2021-2022 Aurimas Cernius
  * Copyright (C) 2010 Debarshi Ray
  * Copyright (C) 2009 Hubert Figuiere
@@ -20,6 +21,9 @@
  */
 
 
+#include <algorithm>
+#include <cstring>
+
 #include <glibmm/stringutils.h>
 
 #include "tagmanager.hpp"
@@ -50,6 +54,7 @@ namespace gnote {
   TagManager::TagManager()
     :  m_tags(Gtk::ListStore::create(m_columns))
     ,  m_sorted_tags(Gtk::TreeModelSort::create(m_tags))
+    ,  m_bulk_load(false)
   {
     m_sorted_tags->set_sort_func (0, sigc::ptr_fun(&compare_tags_sort_func));
     m_sorted_tags->set_sort_column(0, Gtk::SortType::ASCENDING);
@@ -57,6 +62,34 @@ namespace gnote {
   }
 
 
+  // property tags ("a:b:c") and system tags are not shown in tag model
+  bool TagManager::is_internal_tag_name(const Glib::ustring & normalized_tag_name)
+  {
+    const std::string & name = normalized_tag_name.raw();
+    auto colon = name.find(':');
+    if(colon == std::string::npos) {
+      return false;
+    }
+    return name.find(':', colon + 1) != std::string::npos || Glib::str_has_prefix(name, Tag::SYSTEM_TAG_PREFIX);
+  }
+
+  Tag::Ptr TagManager::find_tag(const Glib::ustring & normalized_tag_name) const
+  {
+    auto iter = m_tag_map.find(normalized_tag_name);
+    if (iter != m_tag_map.end()) {
+      Gtk::TreeIter tree_iter = iter->second;
+      return (*tree_iter)[m_columns.m_tag];
+    }
+    if(m_bulk_load) {
+      auto pending = m_pending_tags.find(normalized_tag_name);
+      if(pending != m_pending_tags.end()) {
+        return pending->second;
+      }
+    }
+
+    return Tag::Ptr();
+  }
+
   // <summary>
   // Return an existing tag for the specified tag name.  If no Tag exists
   // null will be returned.
@@ -70,9 +103,7 @@ namespace gnote {
     if (normalized_tag_name.empty())
       throw sharp::Exception ("TagManager.GetTag () called with an empty tag name.");
 
-    std::vector<Glib::ustring> splits;
-    sharp::string_split(splits, normalized_tag_name, ":");
-    if ((splits.size() > 2) || Glib::str_has_prefix(normalized_tag_name, Tag::SYSTEM_TAG_PREFIX)) {
+    if (is_internal_tag_name(normalized_tag_name)) {
       std::lock_guard<std::mutex> lock(m_locker);
       auto iter = m_internal_tags.find(normalized_tag_name);
       if(iter != m_internal_tags.end()) {
@@ -80,13 +111,12 @@ namespace gnote {
       }
       return Tag::Ptr();
     }
-    auto iter = m_tag_map.find(normalized_tag_name);
-    if (iter != m_tag_map.end()) {
-      Gtk::TreeIter tree_iter = iter->second;
-      return (*tree_iter)[m_columns.m_tag];
+    if(m_bulk_load) {
+      std::lock_guard<std::mutex> lock(m_locker);
+      return find_tag(normalized_tag_name);
     }
 
-    return Tag::Ptr();
+    return find_tag(normalized_tag_name);
   }
   
   // <summary>
@@ -101,9 +131,7 @@ namespace gnote {
     if (normalized_tag_name.empty())
       throw sharp::Exception ("TagManager.GetOrCreateTag () called with an empty tag name.");
 
-    std::vector<Glib::ustring> splits;
-    sharp::string_split(splits, normalized_tag_name, ":");
-    if ((splits.size() > 2) || Glib::str_has_prefix(normalized_tag_name, Tag::SYSTEM_TAG_PREFIX)){
+    if (is_internal_tag_name(normalized_tag_name)) {
       std::lock_guard<std::mutex> lock(m_locker);
       auto iter = m_internal_tags.find(normalized_tag_name);
       if(iter != m_internal_tags.end()) {
@@ -115,17 +143,21 @@ namespace gnote {
         return t;
       }
     }
-    Gtk::TreeIter<Gtk::TreeRow> iter;
-    Tag::Ptr tag = get_tag (normalized_tag_name);
+    Tag::Ptr tag = m_bulk_load ? Tag::Ptr() : find_tag(normalized_tag_name);
     if (!tag) {
       std::lock_guard<std::mutex> lock(m_locker);
 
-      tag = get_tag (normalized_tag_name);
+      tag = find_tag(normalized_tag_name);
       if (!tag) {
         tag = std::make_shared<Tag>(sharp::string_trim(tag_name));
-        iter = m_tags->append ();
-        (*iter)[m_columns.m_tag] = tag;
-        m_tag_map [tag->normalized_name()] = iter;
+        if(m_bulk_load) {
+          m_pending_tags[tag->normalized_name()] = tag;
+        }
+        else {
+          auto iter = m_tags->append ();
+          (*iter)[m_columns.m_tag] = tag;
+          m_tag_map [tag->normalized_name()] = iter;
+        }
       }
     }
 
@@ -177,6 +209,11 @@ namespace gnote {
 
       m_internal_tags.erase(tag->normalized_name());
     }
+    if(m_bulk_load) {
+      std::lock_guard<std::mutex> lock(m_locker);
+
+      m_pending_tags.erase(tag->normalized_name());
+    }
     auto map_iter = m_tag_map.find(tag->normalized_name());
     if (map_iter != m_tag_map.end()) {
       std::lock_guard<std::mutex> lock(m_locker);
@@ -217,9 +254,46 @@ namespace gnote {
       iter->second->get_value(0, tag);      
       tags.push_back(tag);
     }
+    for(const auto & pending : m_pending_tags) {
+      tags.push_back(pending.second);
+    }
 
     return tags;
   }
 
+  void TagManager::begin_bulk_load()
+  {
+    std::lock_guard<std::mutex> lock(m_locker);
+    m_bulk_load = true;
+  }
+
+  void TagManager::end_bulk_load()
+  {
+    std::lock_guard<std::mutex> lock(m_locker);
+    m_bulk_load = false;
+    if(m_pending_tags.empty()) {
+      return;
+    }
+
+    std::vector<Tag::Ptr> tags;
+    tags.reserve(m_pending_tags.size());
+    for(const auto & pending : m_pending_tags) {
+      tags.push_back(pending.second);
+    }
+    m_pending_tags.clear();
+    std::sort(tags.begin(), tags.end(), [](const Tag::Ptr & a, const Tag::Ptr & b) {
+      return strcmp(a->normalized_name().c_str(), b->normalized_name().c_str()) < 0;
+    });
+
+    // append unsorted and sort the model once at the end
+    m_sorted_tags->set_sort_column(GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, Gtk::SortType::ASCENDING);
+    for(const auto & tag : tags) {
+      auto iter = m_tags->append();
+      (*iter)[m_columns.m_tag] = tag;
+      m_tag_map[tag->normalized_name()] = iter;
+    }
+    m_sorted_tags->set_sort_column(0, Gtk::SortType::ASCENDING);
+  }
+
 }
 
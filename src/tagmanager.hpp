@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2013,2017,2019,2021-2022 Aurimas Cernius
  * Copyright (C) 2009 Hubert Figuiere
  *
@@ -26,6 +27,7 @@
 
 
 #include <mutex>
+#include <unordered_map>
 #include <sigc++/signal.h>
 
 #include <gtkmm/liststore.h>
@@ -33,6 +35,7 @@
 
 #include "itagmanager.hpp"
 #include "tag.hpp"
+#include "base/hash.hpp"
 
 
 namespace gnote {
@@ -53,7 +56,15 @@ public:
       return m_sorted_tags;
     }
   virtual std::vector<Tag::Ptr> all_tags() const override;
+
+  /// While bulk loading, new tags are only collected and added to the tag model
+  /// in one go by end_bulk_load(), instead of re-sorting the model on every insert.
+  void begin_bulk_load();
+  void end_bulk_load();
 private:
+  static bool is_internal_tag_name(const Glib::ustring & normalized_tag_name);
+  Tag::Ptr find_tag(const Glib::ustring & normalized_tag_name) const;
+
   class ColumnRecord
     : public Gtk::TreeModelColumnRecord
   {
@@ -72,6 +83,9 @@ private:
   TagMap                           m_tag_map;
   typedef std::map<Glib::ustring, Tag::Ptr> InternalMap;
   InternalMap                      m_internal_tags;
+  // tags created during bulk load, not yet in m_tags
+  std::unordered_map<Glib::ustring, Tag::Ptr, Hash<Glib::ustring>> m_pending_tags;
+  bool                             m_bulk_load;
   mutable std::mutex               m_locker;
 };
 
@@ -24,8 +24,10 @@
 #include <giomm/init.h>
 
 #include <UnitTest++/UnitTest++.h>
+#include <UnitTest++/TestReporterStdout.h>
 
-int main(int /*argc*/, char ** /*argv*/)
+// optional argument runs a single suite, e.g. OperationCounts
+int main(int argc, char **argv)
 {
   // force certain timezone so that time tests work
   setenv("TZ", "Europe/London", 1);
@@ -36,8 +38,16 @@ int main(int /*argc*/, char ** /*argv*/)
 
   auto main_loop = Glib::MainLoop::create();
   int ret = 0;
-  std::thread thread([&main_loop, &ret]() {
-    ret = UnitTest::RunAllTests();
+  const char *suite = argc > 1 ? argv[1] : nullptr;
+  std::thread thread([&main_loop, &ret, suite]() {
+    if(suite) {
+      UnitTest::TestReporterStdout reporter;
+      UnitTest::TestRunner runner(reporter);
+      ret = runner.RunTestsIf(UnitTest::Test::GetTestList(), suite, UnitTest::True(), 0);
+    }
+    else {
+      ret = UnitTest::RunAllTests();
+    }
     main_loop->quit();
   });
   main_loop->run();
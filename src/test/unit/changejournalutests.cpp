@@ -0,0 +1,248 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+#include <UnitTest++/UnitTest++.h>
+
+#include "changejournal.hpp"
+#include "sharp/directory.hpp"
+#include "sharp/files.hpp"
+#include "test/testgnote.hpp"
+#include "test/testnotemanager.hpp"
+
+using gnote::ChangeJournal;
+
+
+SUITE(ChangeJournal)
+{
+  struct Fixture
+  {
+    Glib::ustring dir;
+    Glib::ustring journal_file;
+
+    Fixture()
+    {
+      char temp_dir_tmpl[] = "/tmp/gnotetestnotesXXXXXX";
+      dir = g_mkdtemp(temp_dir_tmpl);
+      journal_file = Glib::build_filename(dir, "changes.xml");
+    }
+
+    ~Fixture()
+    {
+      sharp::directory_delete(dir, true);
+    }
+  };
+
+  TEST_FIXTURE(Fixture, changes_since)
+  {
+    ChangeJournal journal(journal_file);
+    CHECK_EQUAL(0, journal.last_seq());
+    CHECK_EQUAL(1, journal.record(ChangeJournal::ChangeType::ADDED, "note://gnote/1", "note1"));
+    CHECK_EQUAL(2, journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/1", "note1"));
+    CHECK_EQUAL(3, journal.record(ChangeJournal::ChangeType::TAG_ADDED, "note://gnote/1", "tag"));
+
+    std::vector<ChangeJournal::Change> changes;
+    CHECK(journal.get_changes_since(1, changes));
+    REQUIRE CHECK_EQUAL(2, changes.size());
+    CHECK_EQUAL(2, changes[0].seq);
+    CHECK(changes[1].type == ChangeJournal::ChangeType::TAG_ADDED);
+    CHECK_EQUAL("tag", changes[1].detail);
+
+    changes.clear();
+    CHECK(journal.get_changes_since(3, changes));
+    CHECK_EQUAL(0, changes.size());
+    CHECK(!journal.get_changes_since(4, changes));
+  }
+
+  TEST_FIXTURE(Fixture, capacity)
+  {
+    ChangeJournal journal(journal_file, 2);
+    journal.record(ChangeJournal::ChangeType::ADDED, "note://gnote/1", "note1");
+    journal.record(ChangeJournal::ChangeType::ADDED, "note://gnote/2", "note2");
+    journal.record(ChangeJournal::ChangeType::DELETED, "note://gnote/1", "note1");
+
+    std::vector<ChangeJournal::Change> changes;
+    CHECK(!journal.get_changes_since(0, changes));
+    CHECK_EQUAL(2, changes.size());
+    changes.clear();
+    CHECK(journal.get_changes_since(1, changes));
+    REQUIRE CHECK_EQUAL(2, changes.size());
+    CHECK_EQUAL("note://gnote/2", changes[0].uri);
+    CHECK(changes[1].type == ChangeJournal::ChangeType::DELETED);
+  }
+
+  TEST_FIXTURE(Fixture, persistence)
+  {
+    {
+      ChangeJournal journal(journal_file);
+      journal.record(ChangeJournal::ChangeType::ADDED, "note://gnote/1", "note <1>");
+      journal.record(ChangeJournal::ChangeType::RENAMED, "note://gnote/1", "note & 2");
+    }
+    CHECK(sharp::file_exists(journal_file));
+
+    ChangeJournal journal(journal_file);
+    CHECK_EQUAL(2, journal.last_seq());
+    std::vector<ChangeJournal::Change> changes;
+    CHECK(journal.get_changes_since(0, changes));
+    REQUIRE CHECK_EQUAL(2, changes.size());
+    CHECK(changes[1].type == ChangeJournal::ChangeType::RENAMED);
+    CHECK_EQUAL("note & 2", changes[1].detail);
+    CHECK_EQUAL(3, journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/1", "note & 2"));
+  }
+
+  TEST_FIXTURE(Fixture, load_with_gaps)
+  {
+    Glib::file_set_contents(journal_file,
+      "<?xml version=\"1.0\"?><changes next-seq=\"8\" last-seq=\"7\">"
+      "<change seq=\"1\" type=\"added\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change seq=\"2\" type=\"unknown\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change seq=\"3\" type=\"saved\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change seq=\"6\" type=\"deleted\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change seq=\"5\" type=\"saved\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change seq=\"7\" type=\"added\" uri=\"note://gnote/2\" detail=\"note2\"/>"
+      "</changes>");
+    ChangeJournal journal(journal_file);
+    CHECK_EQUAL(7, journal.last_seq());
+
+    // change 2 was dropped
+    std::vector<ChangeJournal::Change> changes;
+    CHECK(!journal.get_changes_since(1, changes));
+    REQUIRE CHECK_EQUAL(3, changes.size());
+    CHECK_EQUAL(3, changes[0].seq);
+
+    // out of order change 5 was dropped
+    changes.clear();
+    CHECK(!journal.get_changes_since(3, changes));
+    changes.clear();
+    CHECK(!journal.get_changes_since(4, changes));
+
+    changes.clear();
+    CHECK(journal.get_changes_since(5, changes));
+    REQUIRE CHECK_EQUAL(2, changes.size());
+    CHECK_EQUAL(6, changes[0].seq);
+    CHECK_EQUAL(7, changes[1].seq);
+
+    changes.clear();
+    CHECK(journal.get_changes_since(7, changes));
+    CHECK_EQUAL(0, changes.size());
+    CHECK_EQUAL(8, journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/2", "note2"));
+  }
+
+  TEST_FIXTURE(Fixture, load_malformed)
+  {
+    Glib::file_set_contents(journal_file,
+      "<?xml version=\"1.0\"?><changes next-seq=\"5\" last-seq=\"4\">"
+      "<change seq=\"1\" type=\"added\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change seq=\"2\" type=\"saved\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change type=\"saved\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "<change seq=\"4\" type=\"saved\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "</changes>");
+    ChangeJournal journal(journal_file);
+    CHECK_EQUAL(4, journal.last_seq());
+
+    // loading stopped at the malformed change, everything after it is lost
+    std::vector<ChangeJournal::Change> changes;
+    CHECK(!journal.get_changes_since(2, changes));
+    CHECK(journal.get_changes_since(4, changes));
+    CHECK_EQUAL(0, changes.size());
+  }
+
+  TEST_FIXTURE(Fixture, seqs_not_reused_after_crash)
+  {
+    // saved while numbers up to 100 were reserved, last change handed out is unknown
+    Glib::file_set_contents(journal_file,
+      "<?xml version=\"1.0\"?><changes next-seq=\"101\" last-seq=\"1\">"
+      "<change seq=\"1\" type=\"added\" uri=\"note://gnote/1\" detail=\"note1\"/>"
+      "</changes>");
+    {
+      ChangeJournal journal(journal_file);
+      CHECK_EQUAL(100, journal.last_seq());
+      std::vector<ChangeJournal::Change> changes;
+      CHECK(!journal.get_changes_since(1, changes));
+      CHECK(journal.get_changes_since(100, changes));
+      CHECK_EQUAL(101, journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/1", "note1"));
+    }
+
+    // reservation is written before the number is handed out
+    CHECK(Glib::file_get_contents(journal_file).find("next-seq=\"102\"") != std::string::npos);
+    ChangeJournal journal(journal_file);
+    CHECK_EQUAL(101, journal.last_seq());
+    std::vector<ChangeJournal::Change> changes;
+    CHECK(journal.get_changes_since(100, changes));
+    CHECK_EQUAL(1, changes.size());
+  }
+
+  TEST_FIXTURE(Fixture, note_manager_changes)
+  {
+    test::Gnote g;
+    test::NoteManager manager(test::NoteManager::test_notes_dir(), g);
+    ChangeJournal journal(journal_file);
+    journal.connect(manager);
+
+    auto & note = manager.create("note1");
+    note.add_tag(manager.tag_manager().get_or_create_tag("tag"));
+    note.set_title("note2");
+    manager.delete_note(note);
+
+    std::vector<ChangeJournal::Change> changes;
+    CHECK(journal.get_changes_since(0, changes));
+    REQUIRE CHECK(changes.size() >= 4);
+    CHECK(changes.front().type == ChangeJournal::ChangeType::ADDED);
+    CHECK(changes.back().type == ChangeJournal::ChangeType::DELETED);
+    bool tag_added = false;
+    for(auto & change : changes) {
+      tag_added = tag_added || (change.type == ChangeJournal::ChangeType::TAG_ADDED && change.detail == "tag");
+    }
+    CHECK(tag_added);
+  }
+
+  TEST_FIXTURE(Fixture, batch_coalesces_changes)
+  {
+    ChangeJournal journal(journal_file);
+    gnote::ChangeBatch batch;
+    journal.signal_recorded.connect([&batch](const ChangeJournal::Change & change) {
+      batch.add(change);
+    });
+    CHECK(batch.empty());
+
+    journal.record(ChangeJournal::ChangeType::ADDED, "note://gnote/1", "note1");
+    journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/1", "note1");
+    journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/2", "note2");
+    journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/1", "note1");
+    CHECK(!batch.empty());
+
+    auto changes = batch.take();
+    CHECK(batch.empty());
+    REQUIRE CHECK_EQUAL(3, changes.size());
+    CHECK(changes[0].type == ChangeJournal::ChangeType::ADDED);
+    CHECK_EQUAL(1, changes[0].seq);
+    CHECK_EQUAL("note://gnote/2", changes[1].uri);
+    CHECK_EQUAL(3, changes[1].seq);
+    CHECK_EQUAL("note://gnote/1", changes[2].uri);
+    CHECK(changes[2].type == ChangeJournal::ChangeType::SAVED);
+    CHECK_EQUAL(4, changes[2].seq);
+
+    journal.record(ChangeJournal::ChangeType::SAVED, "note://gnote/1", "note1");
+    changes = batch.take();
+    REQUIRE CHECK_EQUAL(1, changes.size());
+    CHECK_EQUAL(5, changes[0].seq);
+  }
+}
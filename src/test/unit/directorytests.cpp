@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2018-2019,2022 Aurimas Cernius
  *
  * This program is free software: you can redistribute it and/or modify
@@ -18,6 +19,10 @@
  */
 
 
+#include <algorithm>
+
+#include <unistd.h>
+#include <glib/gstdio.h>
 #include <glibmm/miscutils.h>
 #include <UnitTest++/UnitTest++.h>
 
@@ -184,5 +189,28 @@ SUITE(directory)
   {
     directory_get_files_with_ext__same_return_test(".cpp");
   }
-}
 
+  TEST(directory_get_files_with_ext__ustr__file_types)
+  {
+    char temp_dir_tmpl[] = "/tmp/gnotetestdirXXXXXX";
+    Glib::ustring dir = g_mkdtemp(temp_dir_tmpl);
+    for(auto name : {"a.note", "B.NOTE", "c.txt", "note"}) {
+      g_file_set_contents(Glib::build_filename(dir, name).c_str(), "", 0, nullptr);
+    }
+    g_mkdir(Glib::build_filename(dir, "d.note").c_str(), 0700);
+    CHECK_EQUAL(0, symlink("a.note", Glib::build_filename(dir, "e.note").c_str()));
+    CHECK_EQUAL(0, symlink("missing", Glib::build_filename(dir, "f.note").c_str()));
+
+    std::vector<Glib::ustring> files = sharp::directory_get_files_with_ext(dir, ".note");
+    CHECK_EQUAL(3, files.size());
+    for(auto name : {"a.note", "B.NOTE", "e.note"}) {
+      CHECK(std::find(files.begin(), files.end(), Glib::ustring(Glib::build_filename(dir, name))) != files.end());
+    }
+    CHECK_EQUAL(5, sharp::directory_get_files(dir).size());
+
+    for(auto name : {"a.note", "B.NOTE", "c.txt", "note", "d.note", "e.note", "f.note"}) {
+      g_remove(Glib::build_filename(dir, name).c_str());
+    }
+    g_remove(dir.c_str());
+  }
+}
@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2023 Aurimas Cernius
  *
  * This program is free software: you can redistribute it and/or modify
@@ -18,6 +19,11 @@
  */
 
 
+#include <bitset>
+#include <cstdio>
+#include <unordered_set>
+#include <vector>
+
 #include <UnitTest++/UnitTest++.h>
 
 #include "base/hash.hpp"
@@ -31,15 +37,96 @@ SUITE(Hash)
     Glib::ustring tst2 = "Some other string for testing";
 
     gnote::Hash<Glib::ustring> h;
-    std::hash<std::string> check_h;
+    gnote::Hash<std::string_view> check_h;
 
     auto hash1 = h(tst1);
-    auto check1 = check_h(tst1);
+    auto check1 = check_h(tst1.raw());
     CHECK_EQUAL(check1, hash1);
+    CHECK_EQUAL(hash1, h(Glib::ustring("Hello, World!")));
 
     auto hash2 = h(tst2);
-    auto check2 = check_h(tst2);
+    auto check2 = check_h(tst2.raw());
     CHECK_EQUAL(check2, hash2);
+    CHECK(hash1 != hash2);
+  }
+
+  TEST(HashedString)
+  {
+    gnote::HashedString s1(Glib::ustring("note://gnote/1"));
+    gnote::HashedString s2(Glib::ustring("note://gnote/1"));
+    gnote::HashedString s3(Glib::ustring("note://gnote/2"));
+
+    CHECK_EQUAL(gnote::Hash<Glib::ustring>()("note://gnote/1"), s1.hash());
+    CHECK(s1 == s2);
+    CHECK(s1 != s3);
+    CHECK_EQUAL("note://gnote/1", s1.str());
+
+    std::unordered_set<gnote::HashedString, gnote::Hash<gnote::HashedString>> set;
+    set.insert(s1);
+    set.insert(s2);
+    set.insert(s3);
+    CHECK_EQUAL(2, set.size());
+  }
+
+  TEST(hash_bytes_all_lengths)
+  {
+    // every length takes a different path for short inputs, make sure none of them ignores bytes
+    std::vector<unsigned char> data(200, 'a');
+    std::unordered_set<std::uint64_t> hashes;
+    for(std::size_t len = 0; len < data.size(); ++len) {
+      std::uint64_t h = gnote::hash_bytes(data.data(), len);
+      CHECK(hashes.insert(h).second);
+      for(std::size_t i = 0; i < len; ++i) {
+        data[i] = 'b';
+        CHECK(gnote::hash_bytes(data.data(), len) != h);
+        data[i] = 'a';
+      }
+    }
+  }
+
+  TEST(hash_distribution)
+  {
+    // note URIs differ only in a few characters
+    const unsigned count = 100000;
+    const unsigned bucket_count = 1024;
+    std::vector<unsigned> buckets(bucket_count);
+    std::unordered_set<std::uint64_t> hashes;
+    for(unsigned i = 0; i < count; ++i) {
+      char uri[64];
+      int len = std::snprintf(uri, sizeof(uri), "note://gnote/%08x-1b2c-4d5e-8f90-%012u", i * 2654435761u, i);
+      std::uint64_t h = gnote::hash_bytes(uri, len);
+      hashes.insert(h);
+      ++buckets[h % bucket_count];
+    }
+    CHECK_EQUAL(count, hashes.size());
+
+    // chi-square with 1023 degrees of freedom, mean 1023 and standard deviation ~45
+    double expected = double(count) / bucket_count;
+    double chi_square = 0;
+    for(unsigned bucket : buckets) {
+      chi_square += (bucket - expected) * (bucket - expected) / expected;
+    }
+    CHECK(chi_square < 1300);
+  }
+
+  TEST(hash_avalanche)
+  {
+    std::vector<unsigned char> data(64);
+    for(std::size_t i = 0; i < data.size(); ++i) {
+      data[i] = i * 37 + 11;
+    }
+    for(std::size_t len : {1, 3, 8, 15, 16, 17, 40, 64}) {
+      std::uint64_t h = gnote::hash_bytes(data.data(), len);
+      std::size_t changed = 0;
+      for(std::size_t bit = 0; bit < len * 8; ++bit) {
+        data[bit / 8] ^= 1 << (bit % 8);
+        changed += std::bitset<64>(h ^ gnote::hash_bytes(data.data(), len)).count();
+        data[bit / 8] ^= 1 << (bit % 8);
+      }
+      // about half of the output bits should flip for every input bit
+      double average = double(changed) / (len * 8);
+      CHECK(average > 28 && average < 36);
+    }
   }
 }
 
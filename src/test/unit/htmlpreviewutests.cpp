@@ -0,0 +1,157 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <giomm/memoryinputstream.h>
+#include <UnitTest++/UnitTest++.h>
+
+#include "memoryusage.hpp"
+#include "plugins/htmlpreview/htmlpreviewcache.hpp"
+#include "plugins/htmlpreview/htmlpreviewhttp.hpp"
+
+using namespace htmlpreview;
+
+
+SUITE(HtmlPreview)
+{
+  HttpRequest request(const std::string & head)
+  {
+    HttpRequest req;
+    CHECK(parse_request(head, req));
+    return req;
+  }
+
+  TEST(parse_request)
+  {
+    HttpRequest req = request("GET /note/abc?x=1 HTTP/1.1\r\nHost: 127.0.0.1:8765\r\nIf-None-Match:  \"tag\" \r\n\r\n");
+    CHECK_EQUAL("GET", req.method);
+    CHECK_EQUAL("/note/abc", req.path);
+    CHECK_EQUAL("127.0.0.1:8765", req.headers["host"]);
+    CHECK_EQUAL("\"tag\"", req.headers["if-none-match"]);
+
+    HttpRequest bad;
+    CHECK(!parse_request("GET /\r\nHost: localhost\r\n\r\n", bad));
+    CHECK(!parse_request("GET / HTTP/1.1\r\nHost: localhost\r\n", bad));
+    CHECK(!parse_request("GET note HTTP/1.1\r\n\r\n", bad));
+    CHECK(!parse_request("GARBAGE\r\n\r\n", bad));
+  }
+
+  TEST(read_request_is_bounded)
+  {
+    std::string head = "GET / HTTP/1.1\r\nHost: localhost:1\r\n\r\nbody";
+    auto input = Gio::MemoryInputStream::create();
+    input->add_data(head.data(), head.size());
+    HttpRequest req;
+    CHECK(read_request(input, req));
+    CHECK_EQUAL("localhost:1", req.headers["host"]);
+
+    // never ending header is rejected without reading all of it
+    std::string huge = "GET / HTTP/1.1\r\nX: " + std::string(1024 * 1024, 'x');
+    input = Gio::MemoryInputStream::create();
+    input->add_data(huge.data(), huge.size());
+    CHECK(!read_request(input, req));
+    char rest[1];
+    CHECK(input->read(rest, 1) > 0);
+
+    input = Gio::MemoryInputStream::create();
+    CHECK(!read_request(input, req));
+  }
+
+  TEST(host_check)
+  {
+    CHECK(is_local_host(request("GET / HTTP/1.1\r\nHost: 127.0.0.1:8765\r\n\r\n"), 8765));
+    CHECK(is_local_host(request("GET / HTTP/1.1\r\nHost: LocalHost:8765\r\n\r\n"), 8765));
+    CHECK(!is_local_host(request("GET / HTTP/1.1\r\nHost: 127.0.0.1:8766\r\n\r\n"), 8765));
+    CHECK(!is_local_host(request("GET / HTTP/1.1\r\nHost: evil.example:8765\r\n\r\n"), 8765));
+    CHECK(!is_local_host(request("GET / HTTP/1.1\r\n\r\n"), 8765));
+  }
+
+  TEST(page_response_revalidation_and_gzip)
+  {
+    std::string html;
+    for(int i = 0; i < 100; ++i) {
+      html += "<p>Some note text</p>\n";
+    }
+    Page page("note://gnote/1", 10, "", std::string(html));
+    CHECK(page.etag.size() > 2);
+    CHECK(page.etag != Page("note://gnote/1", 11, "", std::string(html)).etag);
+    CHECK(page.etag != Page("note://gnote/1", 10, "font-family:'Sans';", std::string(html)).etag);
+    REQUIRE CHECK(page.gzipped.size() > 2);
+    CHECK(page.gzipped.size() < html.size());
+    CHECK_EQUAL(0x1f, static_cast<unsigned char>(page.gzipped[0]));
+    CHECK_EQUAL(0x8b, static_cast<unsigned char>(page.gzipped[1]));
+
+    HttpResponse response = page_response(request("GET / HTTP/1.1\r\n\r\n"), page);
+    CHECK_EQUAL(200, response.status);
+    CHECK(!response.gzipped);
+    CHECK_EQUAL(html, response.body);
+    CHECK_EQUAL(page.etag, response.etag);
+
+    response = page_response(request("GET / HTTP/1.1\r\nAccept-Encoding: deflate, gzip\r\n\r\n"), page);
+    CHECK(response.gzipped);
+    CHECK_EQUAL(page.gzipped, response.body);
+    std::string head = response_head(response);
+    CHECK(head.find("Content-Encoding: gzip\r\n") != std::string::npos);
+    CHECK(head.find("Content-Length: " + std::to_string(page.gzipped.size()) + "\r\n") != std::string::npos);
+    CHECK(head.find("ETag: " + page.etag + "\r\n") != std::string::npos);
+    CHECK_EQUAL(head.size() - 4, head.find("\r\n\r\n"));
+
+    response = page_response(request("GET / HTTP/1.1\r\nAccept-Encoding: gzip;q=0\r\n\r\n"), page);
+    CHECK(!response.gzipped);
+
+    response = page_response(request("GET / HTTP/1.1\r\nIf-None-Match: \"other\", W/" + page.etag + "\r\n\r\n"), page);
+    CHECK_EQUAL(304, response.status);
+    CHECK(response.body.empty());
+    CHECK(!response_has_body(response));
+    CHECK_EQUAL(0, response_head(response).find("HTTP/1.1 304 Not Modified\r\n"));
+
+    response = page_response(request("GET / HTTP/1.1\r\nIf-None-Match: \"other\"\r\n\r\n"), page);
+    CHECK_EQUAL(200, response.status);
+  }
+
+  TEST(cache_eviction)
+  {
+    auto caches = gnote::memory::usage(gnote::memory::Category::CACHES);
+    {
+      PageCache cache(2);
+      cache.put("note://gnote/1", std::make_shared<Page>("note://gnote/1", 1, "", "one"));
+      cache.put("note://gnote/2", std::make_shared<Page>("note://gnote/2", 1, "", "two"));
+      CHECK(gnote::memory::usage(gnote::memory::Category::CACHES) > caches);
+
+      // stale page is not returned
+      CHECK(!cache.get("note://gnote/1", 2, ""));
+      CHECK(!cache.get("note://gnote/1", 1, "font-family:'Sans';"));
+      // makes 1 most recently used
+      REQUIRE CHECK(cache.get("note://gnote/1", 1, ""));
+      cache.put("note://gnote/3", std::make_shared<Page>("note://gnote/3", 1, "", "three"));
+      CHECK_EQUAL(2, cache.size());
+      CHECK(cache.get("note://gnote/1", 1, ""));
+      CHECK(!cache.get("note://gnote/2", 1, ""));
+      CHECK(cache.get("note://gnote/3", 1, ""));
+
+      cache.put("note://gnote/3", std::make_shared<Page>("note://gnote/3", 2, "", "three"));
+      CHECK_EQUAL(2, cache.size());
+      CHECK(cache.get("note://gnote/3", 2, ""));
+      cache.remove("note://gnote/3");
+      CHECK_EQUAL(1, cache.size());
+      CHECK(!cache.get("note://gnote/3", 2, ""));
+    }
+    CHECK_EQUAL(caches, gnote::memory::usage(gnote::memory::Category::CACHES));
+  }
+}
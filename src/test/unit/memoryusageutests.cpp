@@ -0,0 +1,99 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <UnitTest++/UnitTest++.h>
+
+#include "memoryusage.hpp"
+#include "notebase.hpp"
+#include "tag.hpp"
+#include "test/testgnote.hpp"
+#include "test/testnotemanager.hpp"
+
+using gnote::memory::Category;
+using gnote::memory::usage;
+
+
+SUITE(MemoryUsage)
+{
+  TEST(tracker_adjusts_totals)
+  {
+    std::int64_t before = usage(Category::CACHES);
+    {
+      gnote::memory::Tracker tracker(Category::CACHES);
+      tracker.set(1000);
+      CHECK_EQUAL(before + 1000, usage(Category::CACHES));
+      tracker.set(400);
+      CHECK_EQUAL(before + 400, usage(Category::CACHES));
+
+      gnote::memory::Tracker copy(tracker);
+      CHECK_EQUAL(before + 800, usage(Category::CACHES));
+    }
+    CHECK_EQUAL(before, usage(Category::CACHES));
+  }
+
+  TEST(note_text_is_accounted)
+  {
+    std::int64_t before = usage(Category::NOTE_XML);
+    {
+      gnote::NoteData data("note://gnote/memory");
+      data.set_text(Glib::ustring(1000, 'a'));
+      CHECK(usage(Category::NOTE_XML) >= before + 1000);
+      data.set_text("");
+      CHECK(usage(Category::NOTE_XML) < before + 1000);
+    }
+    CHECK_EQUAL(before, usage(Category::NOTE_XML));
+  }
+
+  TEST(tag_grows_with_notes)
+  {
+    test::Gnote g;
+    test::NoteManager manager(test::NoteManager::test_notes_dir(), g);
+    g.notebook_manager(&manager.notebook_manager());
+    auto & note1 = manager.create("note1");
+    auto & note2 = manager.create("note2");
+
+    std::int64_t before = usage(Category::TAGS);
+    {
+      gnote::Tag tag("memory");
+      std::int64_t empty = usage(Category::TAGS);
+      CHECK(empty > before);
+      tag.add_note(note1);
+      tag.add_note(note2);
+      std::int64_t two_notes = usage(Category::TAGS);
+      CHECK(two_notes > empty);
+      tag.remove_note(note2);
+      CHECK(usage(Category::TAGS) < two_notes);
+      tag.remove_note(note1);
+      CHECK_EQUAL(empty, usage(Category::TAGS));
+    }
+    CHECK_EQUAL(before, usage(Category::TAGS));
+  }
+
+  TEST(title_trie_is_accounted)
+  {
+    test::Gnote g;
+    test::NoteManager manager(test::NoteManager::test_notes_dir(), g);
+    g.notebook_manager(&manager.notebook_manager());
+    std::int64_t before = usage(Category::TITLE_TRIE);
+    manager.create("some fairly long note title");
+    CHECK(usage(Category::TITLE_TRIE) > before);
+  }
+}
+
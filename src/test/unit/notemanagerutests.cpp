@@ -18,6 +18,8 @@
  */
 
 
+#include <algorithm>
+
 #include <UnitTest++/UnitTest++.h>
 
 #include "test/testgnote.hpp"
@@ -143,6 +145,17 @@ SUITE(NoteManager)
     CHECK(&manager.find_by_uri(test_note.uri()).value().get() == &test_note);
   }
 
+  TEST_FIXTURE(Fixture, delete_and_find_by_uri)
+  {
+    auto & note1 = manager.create("note1");
+    auto & note2 = manager.create("note2");
+    Glib::ustring uri1 = note1.uri();
+    manager.delete_note(note1);
+    CHECK_EQUAL(1, manager.note_count());
+    CHECK(!manager.find_by_uri(uri1));
+    CHECK(&manager.find_by_uri(note2.uri()).value().get() == &note2);
+  }
+
   TEST_FIXTURE(Fixture, create_with_xml)
   {
     auto & note = manager.create("test", "<note-content><note-title>test</note-title>\n\ntest content");
@@ -187,5 +200,94 @@ SUITE(NoteManager)
     CHECK_EQUAL("note://gnote/93b3f3ef-9eea-4cdc-9f78-76af1629987a", note.uri());
     CHECK_EQUAL(1, manager.note_count());
   }
-}
 
+  TEST_FIXTURE(Fixture, for_each_by_change_date)
+  {
+    auto & note1 = manager.create("note1");
+    auto & note2 = manager.create("note2");
+    auto & note3 = manager.create("note3");
+    auto now = Glib::DateTime::create_now_local();
+    note1.data().set_change_date(now.add_hours(-1));
+    note1.save();
+    note2.data().set_change_date(now);
+    note2.save();
+    note3.data().set_change_date(now.add_days(-1));
+    note3.save();
+
+    std::vector<gnote::NoteBase*> notes;
+    manager.for_each_by_change_date([&notes](gnote::NoteBase & note) { notes.push_back(&note); });
+    REQUIRE CHECK_EQUAL(3, notes.size());
+    CHECK_EQUAL(&note2, notes[0]);
+    CHECK_EQUAL(&note1, notes[1]);
+    CHECK_EQUAL(&note3, notes[2]);
+
+    note3.data().set_change_date(now.add_hours(1));
+    note3.save();
+    manager.delete_note(note1);
+    notes.clear();
+    manager.for_each_by_change_date([&notes](gnote::NoteBase & note) { notes.push_back(&note); });
+    REQUIRE CHECK_EQUAL(2, notes.size());
+    CHECK_EQUAL(&note3, notes[0]);
+    CHECK_EQUAL(&note2, notes[1]);
+  }
+
+  TEST_FIXTURE(Fixture, notes_snapshot)
+  {
+    CHECK_EQUAL(0, manager.notes_snapshot()->size());
+    auto & note1 = manager.create("note1");
+    manager.create("note2");
+    auto before_delete = manager.notes_snapshot();
+    CHECK_EQUAL(2, before_delete->size());
+
+    Glib::ustring uri1 = note1.uri();
+    manager.delete_note(note1);
+    auto after_delete = manager.notes_snapshot();
+    REQUIRE CHECK_EQUAL(1, after_delete->size());
+    CHECK_EQUAL("note2", (*after_delete)[0]->get_title());
+    // old snapshot is unchanged and keeps deleted note alive
+    REQUIRE CHECK_EQUAL(2, before_delete->size());
+    CHECK(std::any_of(before_delete->begin(), before_delete->end(), [&uri1](const gnote::NoteBase::Ptr & note) {
+      return note->uri() == uri1;
+    }));
+  }
+
+  TEST_FIXTURE(Fixture, bulk_mutation)
+  {
+    auto & note1 = manager.create("note1");
+    auto & note2 = manager.create("note2");
+    manager.create("note3");
+    int ended = 0;
+    manager.signal_bulk_mutation_ended.connect([&ended] { ++ended; });
+    {
+      gnote::NoteManagerBase::BulkMutation bulk(manager);
+      CHECK(manager.in_bulk_mutation());
+      {
+        gnote::NoteManagerBase::BulkMutation nested(manager);
+        manager.delete_note(note1);
+      }
+      CHECK_EQUAL(0, ended);
+      manager.delete_note(note2);
+      CHECK_EQUAL(1, manager.note_count());
+      // snapshot is published when outermost scope ends
+      CHECK_EQUAL(3, manager.notes_snapshot()->size());
+    }
+    CHECK(!manager.in_bulk_mutation());
+    CHECK_EQUAL(1, ended);
+    CHECK_EQUAL(1, manager.notes_snapshot()->size());
+    CHECK(manager.find_trie_matches("note1").empty());
+    CHECK_EQUAL(1, manager.find_trie_matches("note3").size());
+  }
+
+  TEST_FIXTURE(Fixture, delete_notes)
+  {
+    auto & note1 = manager.create("note1");
+    auto & note2 = manager.create("note2");
+    manager.create("note3");
+    int ended = 0;
+    manager.signal_bulk_mutation_ended.connect([&ended] { ++ended; });
+    manager.delete_notes({note1, note2});
+    CHECK_EQUAL(1, ended);
+    CHECK_EQUAL(1, manager.note_count());
+    CHECK_EQUAL(1, manager.notes_snapshot()->size());
+  }
+}
@@ -68,5 +68,26 @@ SUITE(Note)
     auto text = gnote::NoteBase::parse_text_content(std::move(content));
     CHECK_EQUAL("note_title\n\ntext content:\nitem1\nitem2", text);
   }
+
+  TEST(parse_text_content_entities)
+  {
+    Glib::ustring content = "<note-content version=\"0.1\"><note-title>a &amp; b</note-title>\n\n&lt;x&gt; &#65;&#x263A; &quot;&apos;</note-content>";
+    auto text = gnote::NoteBase::parse_text_content(std::move(content));
+    CHECK_EQUAL("a & b\n\n<x> A\u263A \"'", text);
+  }
+
+  TEST(parse_text_content_fallback)
+  {
+    Glib::ustring content = "<note-content><note-title>title</note-title><!-- comment -->\n\n<![CDATA[cdata]]>text\r\n</note-content>";
+    auto text = gnote::NoteBase::parse_text_content(std::move(content));
+    CHECK_EQUAL("title\n\ntext\n", text);
+  }
+
+  TEST(parse_text_content_malformed)
+  {
+    CHECK_EQUAL("", gnote::NoteBase::parse_text_content("<note-content><b>text</note-content>"));
+    CHECK_EQUAL("", gnote::NoteBase::parse_text_content("<note-content>a &unknown; b</note-content>"));
+    CHECK_EQUAL("", gnote::NoteBase::parse_text_content("<note-content>text"));
+  }
 }
 
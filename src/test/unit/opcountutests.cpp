@@ -0,0 +1,195 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Expensive operations done by common actions are counted and bound linearly to the number of notes,
+// so that accidental quadratic behavior fails here before it shows up in profiles.
+
+#include <UnitTest++/UnitTest++.h>
+
+#include "search.hpp"
+#include "sharp/directory.hpp"
+#include "synchronization/silentui.hpp"
+#include "test/testgnote.hpp"
+#include "test/testnote.hpp"
+#include "test/testnotemanager.hpp"
+#include "test/testsyncmanager.hpp"
+#include "tracing.hpp"
+
+using gnote::tracing::Op;
+using gnote::tracing::op_count;
+
+
+SUITE(OperationCounts)
+{
+  Glib::ustring make_note_content(const Glib::ustring & title, const Glib::ustring & body)
+  {
+    return Glib::ustring::compose("<note-content><note-title>%1</note-title>\n\n%2</note-content>", title, body);
+  }
+
+  struct Fixture
+  {
+    test::Gnote g;
+    test::NoteManager manager;
+
+    Fixture()
+      : manager(test::NoteManager::test_notes_dir(), g)
+    {
+      g.notebook_manager(&manager.notebook_manager());
+    }
+  };
+
+  TEST_FIXTURE(Fixture, search_1k_notes)
+  {
+    const unsigned N = 1000;
+    {
+      gnote::NoteManagerBase::BulkMutation bulk(manager);
+      for(unsigned i = 0; i < N; ++i) {
+        manager.create(Glib::ustring::compose("note %1\nsome common text %1", i));
+      }
+    }
+
+    gnote::tracing::reset_op_counts();
+    gnote::Search search(manager);
+    auto results = search.search_notes("common", false, gnote::notebooks::Notebook::ORef());
+    CHECK_EQUAL(N, results.size());
+
+    CHECK(op_count(Op::XML_PARSE) <= N);
+    CHECK_EQUAL(0u, op_count(Op::BUFFER_CREATE));
+    CHECK_EQUAL(0u, op_count(Op::TRIE_REBUILD));
+    CHECK_EQUAL(0u, op_count(Op::FILE_WRITE));
+    CHECK_EQUAL(0u, op_count(Op::REGISTRY_SCAN));
+  }
+
+  TEST_FIXTURE(Fixture, rename_note_linked_from_100_notes)
+  {
+    const unsigned N = 100;
+    auto & target = manager.create("target", make_note_content("target", "linked to"));
+    {
+      gnote::NoteManagerBase::BulkMutation bulk(manager);
+      for(unsigned i = 0; i < N; ++i) {
+        Glib::ustring title = Glib::ustring::compose("linking %1", i);
+        auto content = make_note_content(title, "see <link:internal>target</link:internal>");
+        manager.create(std::move(title), std::move(content));
+      }
+    }
+
+    gnote::tracing::reset_op_counts();
+    target.set_title("renamed target", true);
+    CHECK_EQUAL("renamed target", target.get_title());
+
+    CHECK(op_count(Op::REGISTRY_SCAN) <= 2u);
+    CHECK(op_count(Op::TRIE_REBUILD) <= 1u);
+    CHECK(op_count(Op::FILE_WRITE) <= N + 1);
+    CHECK(op_count(Op::XML_PARSE) <= N);
+    CHECK_EQUAL(0u, op_count(Op::BUFFER_CREATE));
+  }
+
+  struct SyncFixture
+  {
+    Glib::ustring tempdir1;
+    Glib::ustring tempdir2;
+    Glib::ustring syncdir;
+    test::Gnote gnote1;
+    test::Gnote gnote2;
+    test::NoteManager *manager1;
+    test::NoteManager *manager2;
+    test::SyncManager *sync_manager1;
+    test::SyncManager *sync_manager2;
+
+    SyncFixture()
+    {
+      tempdir1 = test::NoteManager::test_notes_dir();
+      tempdir2 = test::NoteManager::test_notes_dir();
+      syncdir = tempdir1 + "/sync";
+      REQUIRE CHECK(sharp::directory_create(syncdir));
+
+      manager1 = new test::NoteManager(tempdir1 + "/notes", gnote1);
+      gnote1.notebook_manager(&manager1->notebook_manager());
+      manager2 = new test::NoteManager(tempdir2 + "/notes", gnote2);
+      gnote2.notebook_manager(&manager2->notebook_manager());
+
+      sync_manager1 = new test::SyncManager(gnote1, *manager1, syncdir);
+      gnote1.sync_manager(sync_manager1);
+      sync_manager2 = new test::SyncManager(gnote2, *manager2, syncdir);
+      gnote2.sync_manager(sync_manager2);
+    }
+
+    ~SyncFixture()
+    {
+      delete sync_manager1;
+      delete sync_manager2;
+      delete manager1;
+      delete manager2;
+      sharp::directory_delete(tempdir1, true);
+      sharp::directory_delete(tempdir2, true);
+    }
+  };
+
+  TEST_FIXTURE(SyncFixture, sync_500_updates)
+  {
+    const unsigned N = 500;
+    {
+      gnote::NoteManagerBase::BulkMutation bulk(*manager1);
+      for(unsigned i = 0; i < N; ++i) {
+        Glib::ustring title = Glib::ustring::compose("note %1", i);
+        auto content = make_note_content(title, "original");
+        manager1->create(std::move(title), std::move(content)).save();
+      }
+    }
+
+    auto & client1 = dynamic_cast<test::SyncClient&>(sync_manager1->get_client(tempdir1 + "/manifest.xml"));
+    auto ui1 = gnote::sync::SilentUI::create(gnote1, *manager1);
+    sync_manager1->perform_synchronization(ui1);
+    sync_manager2->get_client(tempdir2 + "/manifest.xml");
+    auto ui2 = gnote::sync::SilentUI::create(gnote2, *manager2);
+    sync_manager2->perform_synchronization(ui2);
+    REQUIRE CHECK_EQUAL(N, manager2->note_count());
+
+    // same titles, only content changes
+    manager1->for_each([](gnote::NoteBase & note) {
+      auto & test_note = dynamic_cast<test::Note&>(note);
+      test_note.set_xml_content(make_note_content(note.get_title(), "updated"));
+      test_note.set_change_type(gnote::CONTENT_CHANGED);
+      test_note.save();
+    });
+    client1.reparse();
+    sync_manager1->perform_synchronization(ui1);
+
+    gnote::tracing::reset_op_counts();
+    sync_manager2->perform_synchronization(ui2);
+    auto note = manager2->find("note 1");
+    REQUIRE CHECK(note);
+    CHECK(note.value().get().xml_content().find("updated") != Glib::ustring::npos);
+
+    // Every downloaded note is parsed at most:
+    // - once when NoteUpdate reads its title,
+    // - three times in early conflict detection, basically_equal_to() reads the update and
+    //   content of both versions,
+    // - three more times if late conflict detection compares them again,
+    // - twice in load_foreign_note_xml(), validation and reading.
+    // Manifests and lock files add a few per sync, regardless of the number of notes.
+    CHECK(op_count(Op::XML_PARSE) <= 9 * N + 20);
+    // Each scan visits all notes, so even a few per note would be quadratic. Title lookups use one index per sync.
+    CHECK(op_count(Op::REGISTRY_SCAN) <= 2u);
+    CHECK(op_count(Op::FILE_WRITE) <= 4 * N + 20);
+    CHECK(op_count(Op::TRIE_REBUILD) <= 5u);
+  }
+}
+
@@ -0,0 +1,93 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <climits>
+
+#include <UnitTest++/UnitTest++.h>
+
+#include "search.hpp"
+#include "test/testgnote.hpp"
+#include "test/testnotemanager.hpp"
+
+
+SUITE(Search)
+{
+  struct Fixture
+  {
+    test::Gnote g;
+    test::NoteManager manager;
+    gnote::NoteBase *note1;
+    gnote::NoteBase *note2;
+    gnote::NoteBase *note3;
+
+    Fixture()
+      : manager(test::NoteManager::test_notes_dir(), g)
+    {
+      g.notebook_manager(&manager.notebook_manager());
+      note1 = &manager.create("apple pie\napple apple apple");
+      note2 = &manager.create("banana\napple");
+      note3 = &manager.create("cherry\napple apple");
+      manager.create("plum\npear");
+    }
+  };
+
+  TEST_FIXTURE(Fixture, search_notes)
+  {
+    gnote::Search search(manager);
+    auto results = search.search_notes("apple", false, gnote::notebooks::Notebook::ORef());
+    REQUIRE CHECK_EQUAL(3, results.size());
+    CHECK_EQUAL(INT_MAX, results.rbegin()->first);
+    CHECK(&results.rbegin()->second.get() == note1);
+  }
+
+  TEST_FIXTURE(Fixture, result_cache_pages)
+  {
+    gnote::SearchResultCache cache(manager);
+    std::vector<gnote::SearchResultCache::Result> page;
+    CHECK_EQUAL(3, cache.get_page("apple", false, 1, 1, page));
+    REQUIRE CHECK_EQUAL(1, page.size());
+    CHECK_EQUAL(note3->uri(), page[0].second);
+    CHECK_EQUAL(2, page[0].first);
+
+    page.clear();
+    CHECK_EQUAL(3, cache.get_page("apple", false, 0, 10, page));
+    REQUIRE CHECK_EQUAL(3, page.size());
+    CHECK_EQUAL(note1->uri(), page[0].second);
+    CHECK_EQUAL(note3->uri(), page[1].second);
+    CHECK_EQUAL(note2->uri(), page[2].second);
+
+    page.clear();
+    CHECK_EQUAL(3, cache.get_page("apple", false, 5, 10, page));
+    CHECK_EQUAL(0, page.size());
+  }
+
+  TEST_FIXTURE(Fixture, result_cache_invalidation)
+  {
+    gnote::SearchResultCache cache(manager);
+    std::vector<gnote::SearchResultCache::Result> page;
+    CHECK_EQUAL(3, cache.get_page("apple", false, 0, 10, page));
+
+    manager.create("apple tart");
+    page.clear();
+    CHECK_EQUAL(4, cache.get_page("apple", false, 0, 10, page));
+    CHECK_EQUAL(4, page.size());
+  }
+}
+
@@ -27,6 +27,7 @@
 #include "notemanager.hpp"
 #include "sharp/files.hpp"
 #include "sharp/directory.hpp"
+#include "synchronization/filesystemsyncserver.hpp"
 #include "synchronization/silentui.hpp"
 #include "test/testgnote.hpp"
 #include "test/testnote.hpp"
@@ -196,6 +197,42 @@ SUITE(SyncManagerTests)
     CHECK(find_note_in_files("note4"));
   }
 
+  TEST_FIXTURE(Fixture, replace_auto_generated_note)
+  {
+    FIRST_SYNC(gnote1, sync_manager1, manager1, manifest1, sync_client1, sync_ui1)
+
+    // like a template note created locally before the real one syncs
+    create_note(*manager2, "note1", "generated");
+    auto generated_uri = manager2->find("note1").value().get().uri();
+    FIRST_SYNC(gnote2, sync_manager2, manager2, manifest2, sync_client2, sync_ui2)
+
+    CHECK_EQUAL(3, manager2->note_count());
+    CHECK(!manager2->find_by_uri(generated_uri));
+    auto note1 = manager2->find("note1");
+    REQUIRE CHECK(bool(note1));
+    CHECK_EQUAL(manager1->find("note1").value().get().id(), note1.value().get().id());
+    get_notes_in_dir(notesdir2);
+    CHECK_EQUAL(3, files.size());
+  }
+
+  TEST_FIXTURE(Fixture, updates_available_since)
+  {
+    FIRST_SYNC(gnote1, sync_manager1, manager1, manifest1, sync_client1, sync_ui1)
+    {
+      gnote::sync::FileSystemSyncServer server(Gio::File::create_for_path(syncdir), "test");
+      CHECK(server.updates_available_since(-1));
+      CHECK(!server.updates_available_since(0));
+      // unchanged manifest
+      CHECK(!server.updates_available_since(0));
+    }
+
+    create_note(*manager2, "note4", "content4");
+    FIRST_SYNC(gnote2, sync_manager2, manager2, manifest2, sync_client2, sync_ui2)
+    gnote::sync::FileSystemSyncServer server(Gio::File::create_for_path(syncdir), "test");
+    CHECK(server.updates_available_since(0));
+    CHECK(!server.updates_available_since(1));
+  }
+
   TEST_FIXTURE(Fixture, download_new_notes_from_server)
   {
     FIRST_SYNC(gnote1, sync_manager1, manager1, manifest1, sync_client1, sync_ui1)
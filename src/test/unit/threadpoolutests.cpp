@@ -0,0 +1,160 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <future>
+
+#include <UnitTest++/UnitTest++.h>
+
+#include "threadpool.hpp"
+
+using gnote::ThreadPool;
+
+
+SUITE(ThreadPool)
+{
+  // occupies the only worker of a pool until released
+  struct Blocker
+  {
+    std::mutex lock;
+    std::condition_variable cond;
+    bool released = false;
+
+    void block(ThreadPool & pool)
+      {
+        pool.submit([this] {
+          std::unique_lock<std::mutex> guard(lock);
+          cond.wait(guard, [this] { return released; });
+        }, ThreadPool::Priority::HIGH);
+      }
+    void release()
+      {
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          released = true;
+        }
+        cond.notify_all();
+      }
+  };
+
+  TEST(runs_all_tasks)
+  {
+    ThreadPool pool(4);
+    CHECK_EQUAL(4, pool.thread_count());
+    std::atomic<int> count(0);
+    for(int i = 0; i < 1000; ++i) {
+      pool.submit([&pool, &count] {
+        // nested tasks go to the local queue of the worker and get stolen by others
+        for(int j = 0; j < 10; ++j) {
+          pool.submit([&count] { ++count; });
+        }
+        ++count;
+      });
+    }
+    pool.wait_idle();
+    CHECK_EQUAL(11000, count.load());
+  }
+
+  TEST(priorities)
+  {
+    ThreadPool pool(1);
+    Blocker blocker;
+    blocker.block(pool);
+
+    std::mutex lock;
+    std::vector<int> order;
+    auto record = [&lock, &order](int i) {
+      return [&lock, &order, i] {
+        std::lock_guard<std::mutex> guard(lock);
+        order.push_back(i);
+      };
+    };
+    pool.submit(record(1), ThreadPool::Priority::LOW);
+    pool.submit(record(2), ThreadPool::Priority::NORMAL);
+    pool.submit(record(3), ThreadPool::Priority::HIGH);
+    pool.submit(record(4), ThreadPool::Priority::NORMAL);
+    blocker.release();
+    pool.wait_idle();
+
+    REQUIRE CHECK_EQUAL(4, order.size());
+    CHECK_EQUAL(3, order[0]);
+    CHECK_EQUAL(2, order[1]);
+    CHECK_EQUAL(4, order[2]);
+    CHECK_EQUAL(1, order[3]);
+  }
+
+  TEST(cancellation)
+  {
+    ThreadPool pool(1);
+    Blocker blocker;
+    blocker.block(pool);
+
+    bool executed = false;
+    auto cancellable = Gio::Cancellable::create();
+    pool.submit([&executed] { executed = true; }, ThreadPool::Priority::NORMAL, cancellable);
+    cancellable->cancel();
+    blocker.release();
+    pool.wait_idle();
+    CHECK(!executed);
+  }
+
+  TEST(exception_does_not_stop_worker)
+  {
+    ThreadPool pool(1);
+    bool executed = false;
+    pool.submit([] { throw std::runtime_error("test"); });
+    pool.submit([&executed] { executed = true; });
+    pool.wait_idle();
+    CHECK(executed);
+  }
+
+  TEST(completion_in_main_context)
+  {
+    // tests run in a separate thread, main loop runs in main thread
+    ThreadPool pool(2);
+    std::promise<std::pair<int, std::thread::id>> promise;
+    auto result = promise.get_future();
+    pool.run([] { return 42; }, [&promise](int value) {
+      promise.set_value(std::make_pair(value, std::this_thread::get_id()));
+    });
+    REQUIRE CHECK(result.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    auto value = result.get();
+    CHECK_EQUAL(42, value.first);
+    CHECK(value.second != std::this_thread::get_id());
+  }
+
+  TEST(completion_cancelled)
+  {
+    ThreadPool pool(1);
+    Blocker blocker;
+    blocker.block(pool);
+
+    auto cancellable = Gio::Cancellable::create();
+    bool task_executed = false;
+    bool done = false;
+    pool.run([&task_executed] { task_executed = true; }, [&done] { done = true; }, ThreadPool::Priority::NORMAL, cancellable);
+    cancellable->cancel();
+    blocker.release();
+    pool.wait_idle();
+    CHECK(!task_executed);
+    CHECK(!done);
+  }
+}
+
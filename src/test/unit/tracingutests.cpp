@@ -0,0 +1,120 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdio>
+#include <thread>
+
+#include <unistd.h>
+#include <glibmm/fileutils.h>
+#include <UnitTest++/UnitTest++.h>
+
+#include "tracing.hpp"
+
+
+SUITE(Tracing)
+{
+  struct TraceFile
+  {
+    TraceFile()
+      {
+        int fd = mkstemp(name);
+        close(fd);
+      }
+    ~TraceFile()
+      {
+        gnote::tracing::disable();
+        std::remove(name);
+      }
+    std::string dump()
+      {
+        gnote::tracing::disable();
+        if(!gnote::tracing::dump()) {
+          return "";
+        }
+        return Glib::file_get_contents(name);
+      }
+
+    char name[32] = "/tmp/gnotetestXXXXXX";
+  };
+
+  TEST_FIXTURE(TraceFile, records_spans_and_counters)
+  {
+    gnote::tracing::enable(name);
+    CHECK(gnote::tracing::enabled());
+    {
+      TRACE_SPAN("test_span");
+    }
+    TRACE_COUNTER("test_counter", 42);
+    std::thread thread([] {
+      TRACE_SPAN("test_thread_span");
+    });
+    thread.join();
+
+    std::string trace = dump();
+    CHECK_EQUAL(0, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    CHECK(trace.find("\"name\":\"test_span\",\"cat\":\"gnote\",\"ph\":\"X\"") != std::string::npos);
+    CHECK(trace.find("\"name\":\"test_counter\",\"cat\":\"gnote\",\"ph\":\"C\"") != std::string::npos);
+    CHECK(trace.find("\"args\":{\"value\":42}") != std::string::npos);
+    CHECK(trace.find("test_thread_span") != std::string::npos);
+    CHECK(trace.find("\"name\":\"thread_name\"") != std::string::npos);
+    CHECK_EQUAL(trace.size() - 3, trace.rfind("]}\n"));
+  }
+
+  TEST_FIXTURE(TraceFile, disabled_records_nothing)
+  {
+    gnote::tracing::enable(name);
+    gnote::tracing::disable();
+    CHECK(!gnote::tracing::enabled());
+    {
+      TRACE_SPAN("disabled_span");
+    }
+    TRACE_COUNTER("disabled_counter", 1);
+
+    std::string trace = dump();
+    CHECK(!trace.empty());
+    CHECK(trace.find("disabled_span") == std::string::npos);
+    CHECK(trace.find("disabled_counter") == std::string::npos);
+  }
+
+  TEST_FIXTURE(TraceFile, events_before_enable_are_not_dumped)
+  {
+    gnote::tracing::enable(name);
+    TRACE_COUNTER("earlier_counter", 1);
+    gnote::tracing::enable(name);
+    TRACE_COUNTER("later_counter", 2);
+
+    std::string trace = dump();
+    CHECK(trace.find("earlier_counter") == std::string::npos);
+    CHECK(trace.find("later_counter") != std::string::npos);
+  }
+
+  TEST_FIXTURE(TraceFile, full_buffer_keeps_latest_events)
+  {
+    gnote::tracing::enable(name);
+    for(int i = 0; i < 100000; ++i) {
+      TRACE_COUNTER("buffer_counter", i);
+    }
+
+    std::string trace = dump();
+    CHECK(trace.find("\"value\":100}") == std::string::npos);
+    CHECK(trace.find("\"value\":99999}") != std::string::npos);
+  }
+}
+
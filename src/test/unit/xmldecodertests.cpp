@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2023 Aurimas Cernius
  *
  * This program is free software: you can redistribute it and/or modify
@@ -39,5 +40,15 @@ SUITE(XmlDecoder)
     auto decoded = XmlDecoder::decode(note);
     CHECK_EQUAL(plain_text, decoded);
   }
-}
 
+  TEST(decode_references)
+  {
+    CHECK_EQUAL("a < b & \"c\" \u263A", XmlDecoder::decode("<x a='1'>a &lt; b &amp; &quot;c&quot; &#x263A;</x>"));
+  }
+
+  TEST(decode_fallback)
+  {
+    CHECK_EQUAL("ab", XmlDecoder::decode("<x>a<!-- comment -->b</x>"));
+    CHECK_EQUAL("a\nb", XmlDecoder::decode("<x>a\r\nb</x>"));
+  }
+}
@@ -0,0 +1,84 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <UnitTest++/UnitTest++.h>
+
+#include "utils.hpp"
+#include "sharp/xmlwriter.hpp"
+
+using gnote::utils::XmlDecoder;
+using gnote::utils::XmlEncoder;
+
+SUITE(XmlEncoder)
+{
+  Glib::ustring libxml_encode(const Glib::ustring & source)
+  {
+    sharp::XmlWriter xml;
+    xml.write_start_element("", "x", "");
+    xml.write_string(source);
+    xml.write_end_element();
+    xml.close();
+    Glib::ustring result = xml.to_string();
+    result.resize(result.find("</x>"));
+    return result.substr(3);
+  }
+
+  TEST(encode_plain_text)
+  {
+    CHECK_EQUAL("plain text 'quoted'", XmlEncoder::encode("plain text 'quoted'"));
+    CHECK_EQUAL("", XmlEncoder::encode(""));
+  }
+
+  TEST(encode_special_characters)
+  {
+    CHECK_EQUAL("a &lt;b&gt; &amp; &quot;c&quot;", XmlEncoder::encode("a <b> & \"c\""));
+  }
+
+  TEST(encode_matches_libxml)
+  {
+    const char *samples[] = {
+      "",
+      "text",
+      "<link:internal>",
+      "a & b",
+      "\"quoted\" 'text'",
+      "line\r\nline",
+      "☺ é ]]>",
+      "tab\tand\nnewline",
+    };
+    for(auto sample : samples) {
+      CHECK_EQUAL(libxml_encode(sample), XmlEncoder::encode(sample));
+    }
+  }
+
+  TEST(encode_decode_round_trip)
+  {
+    const char *samples[] = {
+      "text",
+      "a <b> & \"c\"",
+      "line\r\nline",
+      "☺ &amp;",
+    };
+    for(auto sample : samples) {
+      CHECK_EQUAL(sample, XmlDecoder::decode("<x>" + XmlEncoder::encode(sample) + "</x>"));
+    }
+  }
+}
+
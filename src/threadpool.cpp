@@ -0,0 +1,189 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+
+#include "debug.hpp"
+#include "threadpool.hpp"
+#include "utils.hpp"
+
+
+namespace gnote {
+
+namespace {
+
+// pool and index of the worker running on current thread
+thread_local const ThreadPool *t_pool = nullptr;
+thread_local unsigned t_worker = 0;
+
+}
+
+
+ThreadPool & ThreadPool::get_default()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+
+ThreadPool::ThreadPool(unsigned thread_count)
+  : m_queued(0)
+  , m_pending(0)
+  , m_next_worker(0)
+  , m_stop(false)
+{
+  if(thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for(unsigned i = 0; i < thread_count; ++i) {
+    m_workers.push_back(std::make_unique<Worker>());
+  }
+  for(unsigned i = 0; i < thread_count; ++i) {
+    m_threads.emplace_back([this, i] { worker_thread(i); });
+  }
+}
+
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for(auto & thread : m_threads) {
+    thread.join();
+  }
+}
+
+
+void ThreadPool::submit(Task && task, Priority priority, const Glib::RefPtr<Gio::Cancellable> & cancellable)
+{
+  // count first, so that the task can not be finished before it is counted
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    ++m_pending;
+    ++m_queued;
+  }
+  // tasks submitted from a worker go to its own queue, others are spread evenly
+  unsigned index = t_pool == this ? t_worker : m_next_worker++ % m_workers.size();
+  {
+    Worker & worker = *m_workers[index];
+    std::lock_guard<std::mutex> lock(worker.lock);
+    worker.queues[static_cast<int>(priority)].push_back(Entry{std::move(task), cancellable});
+  }
+  m_wake.notify_one();
+}
+
+
+void ThreadPool::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(m_lock);
+  m_idle.wait(lock, [this] { return m_pending == 0; });
+}
+
+
+void ThreadPool::invoke_in_main_context(std::function<void()> && func)
+{
+  utils::main_context_invoke([func = std::move(func)]() {
+    func();
+  });
+}
+
+
+bool ThreadPool::take_task(unsigned index, Entry & entry)
+{
+  const unsigned count = m_workers.size();
+  for(int priority = static_cast<int>(Priority::HIGH); priority >= static_cast<int>(Priority::LOW); --priority) {
+    for(unsigned i = 0; i < count; ++i) {
+      Worker & worker = *m_workers[(index + i) % count];
+      std::lock_guard<std::mutex> lock(worker.lock);
+      auto & queue = worker.queues[priority];
+      if(queue.empty()) {
+        continue;
+      }
+      // own tasks in submission order, steal the most recent ones
+      if(i == 0) {
+        entry = std::move(queue.front());
+        queue.pop_front();
+      }
+      else {
+        entry = std::move(queue.back());
+        queue.pop_back();
+      }
+      --m_queued;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+void ThreadPool::finish_task()
+{
+  bool idle;
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    idle = --m_pending == 0;
+  }
+  if(idle) {
+    m_idle.notify_all();
+  }
+}
+
+
+void ThreadPool::worker_thread(unsigned index)
+{
+  t_pool = this;
+  t_worker = index;
+
+  while(true) {
+    Entry entry;
+    if(take_task(index, entry)) {
+      if(!entry.cancellable || !entry.cancellable->is_cancelled()) {
+        try {
+          entry.task();
+        }
+        catch(std::exception & e) {
+          ERR_OUT("Unhandled exception in worker thread: %s", e.what());
+        }
+        catch(...) {
+          ERR_OUT("Unhandled exception in worker thread");
+        }
+      }
+      // release captured state before reporting completion
+      entry = Entry();
+      finish_task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_wake.wait(lock, [this] { return m_stop || m_queued > 0; });
+    if(m_stop && m_queued == 0) {
+      break;
+    }
+  }
+
+  t_pool = nullptr;
+}
+
+}
+
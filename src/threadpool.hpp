@@ -0,0 +1,137 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _THREADPOOL_HPP_
+#define _THREADPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <giomm/cancellable.h>
+
+#include "noncopyable.hpp"
+
+
+namespace gnote {
+
+/// Work stealing pool of worker threads for CPU heavy work (parsing, searching, exporting).
+/// Every worker has its own queues, idle workers take tasks from the others.
+/// Higher priority tasks are always started before lower priority ones.
+class ThreadPool
+  : public NonCopyable
+{
+public:
+  enum class Priority
+  {
+    LOW,
+    NORMAL,
+    HIGH,
+  };
+  typedef std::function<void()> Task;
+
+  /// Pool shared by the whole application, created on first use.
+  static ThreadPool & get_default();
+
+  /// Zero threads means one per CPU core.
+  explicit ThreadPool(unsigned thread_count = 0);
+  /// Finishes all queued tasks before returning.
+  ~ThreadPool();
+
+  /// Queues task for execution. Task is skipped, if cancellable is cancelled before it starts.
+  /// Long running tasks should also check cancellable themselves.
+  void submit(Task && task, Priority priority = Priority::NORMAL,
+              const Glib::RefPtr<Gio::Cancellable> & cancellable = Glib::RefPtr<Gio::Cancellable>());
+
+  /// Runs task in the pool and on_done with its result in the main context.
+  /// on_done is not called if cancellable is cancelled or task throws.
+  template <typename F, typename D>
+  void run(F && task, D && on_done, Priority priority = Priority::NORMAL,
+           const Glib::RefPtr<Gio::Cancellable> & cancellable = Glib::RefPtr<Gio::Cancellable>())
+    {
+      submit([task = std::forward<F>(task), on_done = std::forward<D>(on_done), cancellable]() mutable {
+        auto done = [cancellable](auto && func) {
+          invoke_in_main_context([cancellable, func = std::move(func)]() mutable {
+            if(!cancellable || !cancellable->is_cancelled()) {
+              func();
+            }
+          });
+        };
+        if constexpr(std::is_void_v<std::invoke_result_t<F>>) {
+          task();
+          done(std::move(on_done));
+        }
+        else {
+          auto result = std::make_shared<std::invoke_result_t<F>>(task());
+          done([result, on_done = std::move(on_done)]() mutable {
+            on_done(std::move(*result));
+          });
+        }
+      }, priority, cancellable);
+    }
+
+  /// Blocks until all submitted tasks, including the ones they submit, are finished.
+  void wait_idle();
+  unsigned thread_count() const
+    {
+      return m_threads.size();
+    }
+private:
+  static void invoke_in_main_context(std::function<void()> && func);
+
+  struct Entry
+  {
+    Task task;
+    Glib::RefPtr<Gio::Cancellable> cancellable;
+  };
+  struct Worker
+  {
+    std::mutex lock;
+    // indexed by priority
+    std::deque<Entry> queues[3];
+  };
+
+  void worker_thread(unsigned index);
+  bool take_task(unsigned index, Entry & entry);
+  void finish_task();
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<std::thread> m_threads;
+  std::mutex m_lock;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  // tasks waiting in queues
+  std::atomic<std::size_t> m_queued;
+  // tasks submitted and not yet finished, protected by m_lock
+  std::size_t m_pending;
+  std::atomic<unsigned> m_next_worker;
+  bool m_stop;
+};
+
+}
+
+#endif
+
@@ -0,0 +1,249 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+
+#include <glibmm/fileutils.h>
+
+#include "debug.hpp"
+#include "tracing.hpp"
+
+
+namespace gnote {
+namespace tracing {
+
+std::atomic<bool> s_enabled(false);
+std::atomic<std::uint64_t> s_op_counts[static_cast<int>(Op::COUNT)] = {};
+
+namespace {
+
+// per thread, must be power of two
+const std::uint64_t BUFFER_SIZE = 1 << 16;
+
+struct Event
+{
+  const char *name;
+  std::int64_t timestamp;
+  // duration for spans, value for counters
+  std::int64_t value;
+  char phase;
+};
+
+// written only by owning thread, older events get overwritten when full
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(unsigned id)
+    : tid(id)
+    , head(0)
+    , start(0)
+    , events(BUFFER_SIZE)
+  {}
+
+  const unsigned tid;
+  std::atomic<std::uint64_t> head;
+  // first event to dump, events before it were recorded before enable()
+  std::atomic<std::uint64_t> start;
+  std::vector<Event> events;
+};
+
+std::mutex s_lock;
+// buffers outlive their threads, so that events of finished threads still get dumped
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+std::string s_file;
+std::int64_t s_epoch = 0;
+
+thread_local ThreadBuffer *t_buffer = nullptr;
+
+ThreadBuffer & thread_buffer()
+{
+  if(!t_buffer) {
+    std::lock_guard<std::mutex> lock(s_lock);
+    s_buffers.push_back(std::make_unique<ThreadBuffer>(s_buffers.size() + 1));
+    t_buffer = s_buffers.back().get();
+  }
+  return *t_buffer;
+}
+
+void record(const Event & event)
+{
+  ThreadBuffer & buffer = thread_buffer();
+  std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  buffer.events[head & (BUFFER_SIZE - 1)] = event;
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void append_json_string(std::string & out, const char *str)
+{
+  out += '"';
+  for(; *str; ++str) {
+    if(*str == '"' || *str == '\\') {
+      out += '\\';
+    }
+    out += *str;
+  }
+  out += '"';
+}
+
+// microseconds since enable(), as trace format expects
+void append_time(std::string & out, std::int64_t ns)
+{
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%lld.%03lld", static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+  out += buf;
+}
+
+void append_event(std::string & out, const Event & event, unsigned tid, int pid)
+{
+  char buf[64];
+  out += "{\"name\":";
+  append_json_string(out, event.name);
+  out += ",\"cat\":\"gnote\",\"ph\":\"";
+  out += event.phase;
+  out += "\",\"ts\":";
+  append_time(out, std::max<std::int64_t>(event.timestamp - s_epoch, 0));
+  if(event.phase == 'X') {
+    out += ",\"dur\":";
+    append_time(out, event.value);
+    std::snprintf(buf, sizeof(buf), ",\"pid\":%d,\"tid\":%u}", pid, tid);
+  }
+  else {
+    std::snprintf(buf, sizeof(buf), ",\"pid\":%d,\"tid\":%u,\"args\":{\"value\":%lld}}",
+                  pid, tid, static_cast<long long>(event.value));
+  }
+  out += buf;
+}
+
+}
+
+
+std::int64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void enable(const std::string & file)
+{
+  {
+    std::lock_guard<std::mutex> lock(s_lock);
+    s_file = file;
+    s_epoch = now();
+    for(auto & buffer : s_buffers) {
+      buffer->start.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+  }
+  s_enabled.store(true, std::memory_order_release);
+}
+
+
+void enable_from_environment()
+{
+  const char *file = std::getenv("GNOTE_TRACE");
+  if(file && *file) {
+    enable(file);
+  }
+}
+
+
+void disable()
+{
+  s_enabled.store(false, std::memory_order_release);
+}
+
+
+std::uint64_t op_count(Op op)
+{
+  return s_op_counts[static_cast<int>(op)].load(std::memory_order_relaxed);
+}
+
+
+void reset_op_counts()
+{
+  for(auto & count : s_op_counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+
+void record_span(const char *name, std::int64_t start, std::int64_t end)
+{
+  record(Event{name, start, end - start, 'X'});
+}
+
+
+void record_counter(const char *name, std::int64_t value)
+{
+  record(Event{name, now(), value, 'C'});
+}
+
+
+bool dump()
+{
+  std::string file;
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  {
+    std::lock_guard<std::mutex> lock(s_lock);
+    if(s_file.empty()) {
+      return false;
+    }
+    file = s_file;
+
+    const int pid = getpid();
+    bool first = true;
+    char buf[128];
+    for(auto & buffer : s_buffers) {
+      std::snprintf(buf, sizeof(buf), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                    first ? "" : ",", pid, buffer->tid, buffer->tid);
+      out += buf;
+      first = false;
+
+      // events still being written by other threads might come out torn, dump when quiet
+      std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+      std::uint64_t start = std::max(buffer->start.load(std::memory_order_relaxed),
+                                     head > BUFFER_SIZE ? head - BUFFER_SIZE : 0);
+      for(std::uint64_t i = start; i < head; ++i) {
+        out += ",\n";
+        append_event(out, buffer->events[i & (BUFFER_SIZE - 1)], buffer->tid, pid);
+      }
+    }
+  }
+  out += "]}\n";
+
+  try {
+    Glib::file_set_contents(file, out);
+  }
+  catch(Glib::FileError & e) {
+    ERR_OUT("Failed to write trace to %s: %s", file.c_str(), e.what());
+    return false;
+  }
+  return true;
+}
+
+}
+}
+
@@ -0,0 +1,130 @@
+/*
+ * gnote
+ *
+ * Copyright (C) 2026 Gnote developers
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _TRACING_HPP_
+#define _TRACING_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+
+/// Low overhead tracing of timed spans and counters.
+/// Disabled by default, costing one predictable branch per span. When enabled, events go to
+/// per thread ring buffers without locking and are written in Chrome trace format (viewable in
+/// Perfetto or chrome://tracing) by dump().
+/// Span and counter names must be string literals, only pointers to them are recorded.
+namespace gnote {
+namespace tracing {
+
+extern std::atomic<bool> s_enabled;
+
+inline bool enabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+/// Starts recording, events are written to file by dump().
+void enable(const std::string & file);
+/// Enables tracing if GNOTE_TRACE environment variable holds a file name.
+void enable_from_environment();
+void disable();
+/// Writes events recorded since enable() to the file, returns false on failure.
+bool dump();
+
+/// Monotonic time in nanoseconds.
+std::int64_t now();
+void record_span(const char *name, std::int64_t start, std::int64_t end);
+void record_counter(const char *name, std::int64_t value);
+
+
+/// Operations whose number should grow with the work done, not faster.
+/// Always counted, at the cost of one relaxed atomic increment. Tests assert upper bounds on them,
+/// so that complexity regressions fail regardless of machine speed.
+enum class Op
+{
+  XML_PARSE,
+  BUFFER_CREATE,
+  TRIE_REBUILD,
+  FILE_WRITE,
+  REGISTRY_SCAN,
+  COUNT
+};
+
+extern std::atomic<std::uint64_t> s_op_counts[static_cast<int>(Op::COUNT)];
+
+inline void count_op(Op op)
+{
+  s_op_counts[static_cast<int>(op)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t op_count(Op op);
+void reset_op_counts();
+
+
+class Span
+{
+public:
+  explicit Span(const char *name)
+    : m_name(nullptr)
+    , m_start(0)
+    {
+      if(enabled()) {
+        m_name = name;
+        m_start = now();
+      }
+    }
+  ~Span()
+    {
+      if(m_name) {
+        record_span(m_name, m_start, now());
+      }
+    }
+  Span(const Span &) = delete;
+  Span & operator=(const Span &) = delete;
+private:
+  const char *m_name;
+  std::int64_t m_start;
+};
+
+}
+}
+
+
+#define GNOTE_TRACE_CONCAT_(a, b) a##b
+#define GNOTE_TRACE_CONCAT(a, b) GNOTE_TRACE_CONCAT_(a, b)
+
+/// Times the rest of the enclosing scope.
+#define TRACE_SPAN(name) \
+  ::gnote::tracing::Span GNOTE_TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+/// Counts one operation, op is a name from tracing::Op.
+#define TRACE_OP(op) \
+  ::gnote::tracing::count_op(::gnote::tracing::Op::op)
+
+#define TRACE_COUNTER(name, value) \
+  do { \
+    if(::gnote::tracing::enabled()) { \
+      ::gnote::tracing::record_counter(name, value); \
+    } \
+  } while(0)
+
+#endif
+
@@ -261,6 +261,15 @@ public:
     return m_max_length;
   }
 
+  // Approximate, heap data owned by payloads is not included.
+  size_t memory_size() const
+  {
+    // common std::deque implementations allocate a map and a block even when empty
+    const size_t deque_storage = 8 * sizeof(void*) + 512;
+    return sizeof(*this) + m_states.capacity() * sizeof(TrieStatePtr)
+      + m_states.size() * (sizeof(TrieState) + deque_storage);
+  }
+
 };
 
 }
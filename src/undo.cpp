@@ -56,6 +56,7 @@ namespace gnote {
 
   ChopBuffer::ChopBuffer(const Glib::RefPtr<Gtk::TextTagTable> & table)
     : Gtk::TextBuffer(table)
+    , m_memory(memory::Category::UNDO)
   {
   }
 
@@ -69,6 +70,7 @@ namespace gnote {
     chop_start = end().get_offset();
     insert (current_end, start_iter, end_iter);
     chop_end = end().get_offset();
+    m_memory.set(memory::text_buffer_bytes(chop_end));
 
     return utils::TextRange (get_iter_at_offset (chop_start),
                              get_iter_at_offset (chop_end));
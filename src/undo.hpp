@@ -30,6 +30,7 @@
 #include <gtkmm/texttag.h>
 #include <gtkmm/textiter.h>
 
+#include "memoryusage.hpp"
 #include "noncopyable.hpp"
 #include "notebuffer.hpp"
 #include "utils.hpp"
@@ -73,6 +74,9 @@ public:
   typedef Glib::RefPtr<ChopBuffer> Ptr;
   ChopBuffer(const Glib::RefPtr<Gtk::TextTagTable> & table);
   utils::TextRange add_chop(const Gtk::TextIter & start_iter, const Gtk::TextIter & end_iter);
+private:
+  // chops are only appended, for as long as the note buffer lives
+  memory::Tracker m_memory;
 };
 
 
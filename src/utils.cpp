@@ -1,6 +1,7 @@
 /*
  * gnote
  *
+ * Copyright (C) 2026 Gnote developers
  * Copyright (C) 2010-2017,2019-2024 Aurimas Cernius
  * Copyright (C) 2010 Debarshi Ray
  * Copyright (C) 2009 Hubert Figuiere
@@ -32,8 +33,8 @@
 #include <gtkmm/label.h>
 #include <gtkmm/urilauncher.h>
 
+#include "sharp/xml.hpp"
 #include "sharp/xmlreader.hpp"
-#include "sharp/xmlwriter.hpp"
 #include "sharp/string.hpp"
 #include "sharp/uri.hpp"
 #include "preferences.hpp"
@@ -127,84 +128,96 @@ namespace gnote {
       return get_pretty_print_date(date, show_time, use_12h);
     }
 
-    // separate function for testing purposes
-    Glib::ustring get_pretty_print_date(const Glib::DateTime& date, bool show_time, bool use_12h, const Glib::DateTime& now)
-    {
-      Glib::ustring short_time = use_12h
-        /* TRANSLATORS: time in 12h format. */
-        ? sharp::date_time_to_string(date, "%l:%M %P")
-        /* TRANSLATORS: time in 24h format. */
-        : sharp::date_time_to_string(date, "%H:%M");
-
-      enum class Format
+    namespace {
+      PrettyDateFormat get_pretty_date_format(const Glib::DateTime & date, const Glib::DateTime & now)
       {
-        TODAY,
-        TOMORROW,
-        YESTERDAY,
-        CURRENT_YEAR,
-        OTHER_YEAR,
-      } format = Format::OTHER_YEAR;
-
-      if(date.get_year() == now.get_year()) {
-        if(date.get_day_of_year() == now.get_day_of_year()) {
-          format = Format::TODAY;
-        }
-        else if((date.get_day_of_year() == now.get_day_of_year() - 1)) {
-          format = Format::YESTERDAY;
+        if(date.get_year() == now.get_year()) {
+          if(date.get_day_of_year() == now.get_day_of_year()) {
+            return PrettyDateFormat::TODAY;
+          }
+          else if((date.get_day_of_year() == now.get_day_of_year() - 1)) {
+            return PrettyDateFormat::YESTERDAY;
+          }
+          else if(date.get_day_of_year() == now.get_day_of_year() + 1) {
+            return PrettyDateFormat::TOMORROW;
+          }
+          else {
+            return PrettyDateFormat::CURRENT_YEAR;
+          }
         }
-        else if(date.get_day_of_year() == now.get_day_of_year() + 1) {
-          format = Format::TOMORROW;
+        else if(date.get_year() + 1 == now.get_year() && date.get_month() == 12 && date.get_day_of_month() == 31
+                && now.get_month() == 1 && now.get_day_of_month() == 1) {
+          return PrettyDateFormat::YESTERDAY;
         }
-        else {
-          format = Format::CURRENT_YEAR;
+        else if(date.get_year() == now.get_year() + 1 && date.get_month() == 1 && date.get_day_of_month() == 1
+                && now.get_month() == 12 && now.get_day_of_month() == 31) {
+          return PrettyDateFormat::TOMORROW;
         }
+
+        return PrettyDateFormat::OTHER_YEAR;
       }
-      else if(date.get_year() + 1 == now.get_year() && date.get_month() == 12 && date.get_day_of_month() == 31
-              && now.get_month() == 1 && now.get_day_of_month() == 1) {
-        format = Format::YESTERDAY;
+
+      Glib::ustring get_pretty_short_time(const Glib::DateTime & date, bool use_12h)
+      {
+        return use_12h
+          /* TRANSLATORS: time in 12h format. */
+          ? sharp::date_time_to_string(date, "%l:%M %P")
+          /* TRANSLATORS: time in 24h format. */
+          : sharp::date_time_to_string(date, "%H:%M");
       }
-      else if(date.get_year() == now.get_year() + 1 && date.get_month() == 1 && date.get_day_of_month() == 1
-              && now.get_month() == 12 && now.get_day_of_month() == 31) {
-        format = Format::TOMORROW;
+
+      // The date part for non-relative formats, empty for today, tomorrow and yesterday
+      Glib::ustring get_pretty_day(PrettyDateFormat format, const Glib::DateTime & date)
+      {
+        switch(format) {
+        case PrettyDateFormat::CURRENT_YEAR:
+          /* TRANSLATORS: date in current year. */
+          return sharp::date_time_to_string(date, _("%b %d")); // "MMMM d"
+        case PrettyDateFormat::OTHER_YEAR:
+          /* TRANSLATORS: date in other than current year. */
+          return sharp::date_time_to_string(date, _("%b %d %Y")); // "MMMM d yyyy"
+        default:
+          return Glib::ustring();
+        }
       }
 
-      Glib::ustring pretty_str;
-      switch(format) {
-      case Format::TODAY:
-        pretty_str = show_time
-          /* TRANSLATORS: argument %1 is time. */
-          ? Glib::ustring::compose(_("Today, %1"), short_time)
-          : _("Today");
-        break;
-      case Format::TOMORROW:
-        pretty_str = show_time
-          /* TRANSLATORS: argument %1 is time. */
-          ? Glib::ustring::compose(_("Tomorrow, %1"), short_time)
-          : _("Tomorrow");
-        break;
-      case Format::YESTERDAY:
-        pretty_str = show_time
-          /* TRANSLATORS: argument %1 is time. */
-          ? Glib::ustring::compose(_("Yesterday, %1"), short_time)
-          : _("Yesterday");
-        break;
-      case Format::CURRENT_YEAR:
-        /* TRANSLATORS: date in current year. */
-        pretty_str = sharp::date_time_to_string(date, _("%b %d")); // "MMMM d"
-        goto DATE_AND_TIME;
-      case Format::OTHER_YEAR:
-        /* TRANSLATORS: date in other than current year. */
-        pretty_str = sharp::date_time_to_string(date, _("%b %d %Y")); // "MMMM d yyyy"
-        goto DATE_AND_TIME;
-      DATE_AND_TIME:
-        if(show_time) {
-          /* TRANSLATORS: argument %1 is date, %2 is time. */
-          pretty_str = Glib::ustring::compose(_("%1, %2"), pretty_str, short_time);
+      Glib::ustring compose_pretty_date(PrettyDateFormat format, const Glib::ustring & day, bool show_time, const Glib::ustring & short_time)
+      {
+        switch(format) {
+        case PrettyDateFormat::TODAY:
+          return show_time
+            /* TRANSLATORS: argument %1 is time. */
+            ? Glib::ustring::compose(_("Today, %1"), short_time)
+            : _("Today");
+        case PrettyDateFormat::TOMORROW:
+          return show_time
+            /* TRANSLATORS: argument %1 is time. */
+            ? Glib::ustring::compose(_("Tomorrow, %1"), short_time)
+            : _("Tomorrow");
+        case PrettyDateFormat::YESTERDAY:
+          return show_time
+            /* TRANSLATORS: argument %1 is time. */
+            ? Glib::ustring::compose(_("Yesterday, %1"), short_time)
+            : _("Yesterday");
+        default:
+          if(show_time) {
+            /* TRANSLATORS: argument %1 is date, %2 is time. */
+            return Glib::ustring::compose(_("%1, %2"), day, short_time);
+          }
+          return day;
         }
-        break;
       }
+    }
 
-      return pretty_str;
+    // separate function for testing purposes
+    Glib::ustring get_pretty_print_date(const Glib::DateTime& date, bool show_time, bool use_12h, const Glib::DateTime& now)
+    {
+      PrettyDateFormat format = get_pretty_date_format(date, now);
+      Glib::ustring short_time;
+      if(show_time) {
+        short_time = get_pretty_short_time(date, use_12h);
+      }
+      return compose_pretty_date(format, get_pretty_day(format, date), show_time, short_time);
     }
 
     Glib::ustring get_pretty_print_date(const Glib::DateTime & date, bool show_time, bool use_12h)
@@ -216,6 +229,63 @@ namespace gnote {
       return get_pretty_print_date(date, show_time, use_12h, Glib::DateTime::create_now_local());
     }
 
+    PrettyDateCache::PrettyDateCache(bool show_time, bool use_12h)
+      : m_show_time(show_time)
+      , m_use_12h(use_12h)
+      , m_today_end(0)
+    {
+    }
+
+    void PrettyDateCache::use_12h(bool value)
+    {
+      if(m_use_12h != value) {
+        m_use_12h = value;
+        m_times.clear();
+      }
+    }
+
+    void PrettyDateCache::clear()
+    {
+      m_days.clear();
+      m_times.clear();
+      m_today_end = 0;
+    }
+
+    Glib::ustring PrettyDateCache::get(const Glib::DateTime & date)
+    {
+      if(!date) {
+        return _("No Date");
+      }
+
+      // relative days (today, yesterday) move at midnight
+      if(g_get_real_time() >= m_today_end) {
+        m_days.clear();
+        m_now = Glib::DateTime::create_now_local();
+        auto tomorrow = Glib::DateTime::create_local(m_now.get_year(), m_now.get_month(), m_now.get_day_of_month(), 0, 0, 0).add_days(1);
+        m_today_end = tomorrow.to_unix() * G_USEC_PER_SEC;
+      }
+
+      int day_key = date.get_year() * 1000 + date.get_day_of_year();
+      auto day = m_days.find(day_key);
+      if(day == m_days.end()) {
+        PrettyDateFormat format = get_pretty_date_format(date, m_now);
+        day = m_days.emplace(day_key, std::make_pair(format, get_pretty_day(format, date))).first;
+      }
+
+      if(!m_show_time) {
+        return compose_pretty_date(day->second.first, day->second.second, false, Glib::ustring());
+      }
+
+      int time_key = date.get_hour() * 60 + date.get_minute();
+      auto time = m_times.find(time_key);
+      if(time == m_times.end()) {
+        time = m_times.emplace(time_key, get_pretty_short_time(date, m_use_12h)).first;
+      }
+
+      return compose_pretty_date(day->second.first, day->second.second, true, time->second);
+    }
+
+
     void main_context_invoke(const sigc::slot<void()> & slot)
     {
       auto data = new sigc::slot<void()>(slot);
@@ -395,25 +465,54 @@ namespace gnote {
 
     Glib::ustring XmlEncoder::encode(const Glib::ustring & source)
     {
-      sharp::XmlWriter xml;
-      //need element so that source is properly escaped
-      xml.write_start_element("", "x", "");
-      xml.write_string(source);
-      xml.write_end_element();
+      // same characters as escaped by libxml in element content
+      auto needs_escape = [](char c) {
+        return c == '&' || c == '<' || c == '>' || c == '"' || c == '\r';
+      };
+      const std::string & raw = source.raw();
+      auto iter = std::find_if(raw.begin(), raw.end(), needs_escape);
+      if(iter == raw.end()) {
+        return source;
+      }
 
-      xml.close();
-      Glib::ustring result = xml.to_string();
-      Glib::ustring::size_type end_pos = result.find("</x>");
-      if(end_pos == result.npos) {
-        return "";
+      std::string result;
+      result.reserve(raw.size() + 16);
+      result.append(raw.begin(), iter);
+      for(; iter != raw.end(); ++iter) {
+        switch(*iter) {
+        case '&':
+          result += "&amp;";
+          break;
+        case '<':
+          result += "&lt;";
+          break;
+        case '>':
+          result += "&gt;";
+          break;
+        case '"':
+          result += "&quot;";
+          break;
+        case '\r':
+          result += "&#13;";
+          break;
+        default:
+          result += *iter;
+          break;
+        }
       }
-      result.resize(end_pos);
-      return result.substr(3);
+
+      return Glib::ustring(std::move(result));
     }
 
 
     Glib::ustring XmlDecoder::decode(const Glib::ustring & source)
     {
+      std::string text;
+      text.reserve(source.bytes());
+      if(sharp::xml_extract_text(source.data(), source.data() + source.bytes(), text)) {
+        return Glib::ustring(std::move(text));
+      }
+
       Glib::ustring builder;
 
       sharp::XmlReader xml;
@@ -23,6 +23,8 @@
 #ifndef _GNOTE_UTILS_HPP__
 #define _GNOTE_UTILS_HPP__
 
+#include <unordered_map>
+
 #include <sigc++/signal.h>
 
 #include <glibmm/datetime.h>
@@ -53,6 +55,32 @@ class Preferences;
     Glib::ustring get_pretty_print_date(const Glib::DateTime &, bool show_time, Preferences & preferences);
     Glib::ustring get_pretty_print_date(const Glib::DateTime &, bool show_time, bool use_12h);
 
+    enum class PrettyDateFormat
+    {
+      TODAY,
+      TOMORROW,
+      YESTERDAY,
+      CURRENT_YEAR,
+      OTHER_YEAR,
+    };
+
+    // Pretty prints dates for long lists, formatting each day and time of day only once
+    class PrettyDateCache
+    {
+    public:
+      PrettyDateCache(bool show_time, bool use_12h);
+      Glib::ustring get(const Glib::DateTime & date);
+      void use_12h(bool value);
+      void clear();
+    private:
+      const bool m_show_time;
+      bool m_use_12h;
+      gint64 m_today_end;
+      Glib::DateTime m_now;
+      std::unordered_map<int, std::pair<PrettyDateFormat, Glib::ustring>> m_days;
+      std::unordered_map<int, Glib::ustring> m_times;
+    };
+
     void main_context_invoke(const sigc::slot<void()> & slot);
     void main_context_call(const sigc::slot<void()> & slot);
     void timeout_add_once(guint interval, std::function<void()> func);
@@ -24,6 +24,8 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
+
 #include <glibmm/i18n.h>
 #include <glibmm/stringutils.h>
 #include <gtkmm/eventcontrollerfocus.h>
@@ -685,6 +687,8 @@ namespace gnote {
       sigc::mem_fun(*this, &AppLinkWatcher::on_note_added));
     m_on_note_renamed_cid = note_manager().signal_note_renamed.connect(
       sigc::mem_fun(*this, &AppLinkWatcher::on_note_renamed));
+    m_on_bulk_mutation_ended_cid = note_manager().signal_bulk_mutation_ended.connect(
+      sigc::mem_fun(*this, &AppLinkWatcher::on_bulk_mutation_ended));
   }
 
   void AppLinkWatcher::shutdown()
@@ -693,6 +697,9 @@ namespace gnote {
     m_on_note_deleted_cid.disconnect();
     m_on_note_added_cid.disconnect();
     m_on_note_renamed_cid.disconnect();
+    m_on_bulk_mutation_ended_cid.disconnect();
+    m_bulk_added_titles.clear();
+    m_bulk_deleted_titles.clear();
   }
 
   bool AppLinkWatcher::initialized()
@@ -702,12 +709,45 @@ namespace gnote {
 
   void AppLinkWatcher::on_note_added(NoteBase & added)
   {
-    note_manager().for_each([this, &added](NoteBase & note) {
-      if(&added == &note) {
-        return;
-      }
+    if(note_manager().in_bulk_mutation()) {
+      m_bulk_added_titles.emplace_back(added.get_title().lowercase(), added.uri());
+      return;
+    }
+    highlight_added_titles({AddedTitle(added.get_title().lowercase(), added.uri())});
+  }
+
+  void AppLinkWatcher::on_note_deleted(NoteBase & deleted)
+  {
+    if(note_manager().in_bulk_mutation()) {
+      m_bulk_deleted_titles.push_back(deleted.get_title().lowercase());
+      return;
+    }
+    break_deleted_links({deleted.get_title().lowercase()});
+  }
+
+  void AppLinkWatcher::on_bulk_mutation_ended()
+  {
+    std::vector<AddedTitle> added;
+    std::vector<Glib::ustring> deleted;
+    std::swap(added, m_bulk_added_titles);
+    std::swap(deleted, m_bulk_deleted_titles);
+    // one pass over all notes, instead of one per changed note
+    if(!deleted.empty()) {
+      break_deleted_links(deleted);
+    }
+    if(!added.empty()) {
+      highlight_added_titles(added);
+    }
+  }
 
-      if(!contains_text(note, added.get_title())) {
+  void AppLinkWatcher::highlight_added_titles(const std::vector<AddedTitle> & added)
+  {
+    note_manager().for_each([this, &added](NoteBase & note) {
+      Glib::ustring body = note.text_content().lowercase();
+      // added note does not link to itself, but notes added together link to each other
+      if(std::none_of(added.begin(), added.end(), [&note, &body](const AddedTitle & title) {
+           return title.second != note.uri() && body.find(title.first) != Glib::ustring::npos;
+         })) {
         return;
       }
 
@@ -718,29 +758,29 @@ namespace gnote {
     });
   }
 
-  void AppLinkWatcher::on_note_deleted(NoteBase & deleted)
+  void AppLinkWatcher::break_deleted_links(const std::vector<Glib::ustring> & titles_lower)
   {
-    auto tag_table = static_cast<Note&>(deleted).get_tag_table();
-    auto link_tag = tag_table->get_link_tag();
-    auto broken_link_tag = tag_table->get_broken_link_tag();
-
-    note_manager().for_each([this, &deleted, &link_tag, &broken_link_tag](NoteBase & note) {
-      if(&deleted == &note) {
+    // deleted notes are no longer in manager
+    note_manager().for_each([&titles_lower](NoteBase & note) {
+      Glib::ustring body = note.text_content().lowercase();
+      if(std::none_of(titles_lower.begin(), titles_lower.end(), [&body](const Glib::ustring & title) {
+           return body.find(title) != Glib::ustring::npos;
+         })) {
         return;
       }
 
-      if(!contains_text(note, deleted.get_title())) {
-        return;
-      }
-
-      Glib::ustring old_title_lower = deleted.get_title().lowercase();
-      auto buffer = static_cast<Note&>(note).get_buffer();
+      auto & n = static_cast<Note&>(note);
+      auto tag_table = n.get_tag_table();
+      auto link_tag = tag_table->get_link_tag();
+      auto broken_link_tag = tag_table->get_broken_link_tag();
+      auto buffer = n.get_buffer();
 
-      // Turn all link:internal to link:broken for the deleted note.
+      // Turn all link:internal to link:broken for the deleted notes.
       utils::TextTagEnumerator enumerator(buffer, link_tag);
       while(enumerator.move_next()) {
         const utils::TextRange & range(enumerator.current());
-        if(enumerator.current().text().lowercase() != old_title_lower)
+        Glib::ustring link_lower = range.text().lowercase();
+        if(std::find(titles_lower.begin(), titles_lower.end(), link_lower) == titles_lower.end())
           continue;
 
         buffer->remove_tag(link_tag, range.start(), range.end());
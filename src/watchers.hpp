@@ -192,11 +192,20 @@ namespace gnote {
     void on_note_added(NoteBase &);
     void on_note_deleted(NoteBase &);
     void on_note_renamed(const NoteBase&, const Glib::ustring&);
+    void on_bulk_mutation_ended();
+    // lowercase title and uri of the added note
+    typedef std::pair<Glib::ustring, Glib::ustring> AddedTitle;
+    void highlight_added_titles(const std::vector<AddedTitle> & added);
+    void break_deleted_links(const std::vector<Glib::ustring> & titles_lower);
 
     bool m_initialized;
     sigc::connection m_on_note_deleted_cid;
     sigc::connection m_on_note_added_cid;
     sigc::connection m_on_note_renamed_cid;
+    sigc::connection m_on_bulk_mutation_ended_cid;
+    // processed together when bulk mutation ends
+    std::vector<AddedTitle> m_bulk_added_titles;
+    std::vector<Glib::ustring> m_bulk_deleted_titles; // lowercase
   };
 
 